@@ -0,0 +1,95 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+struct Inner
+{
+    int id;
+    float values;
+};
+
+struct Outer
+{
+    std::string name;
+    Inner inner;
+};
+
+int main()
+{
+    const size_t iterations = 10000000;
+
+    rt::Struct inner("Inner");
+    inner.add_member<int>("id");
+    inner.add_member<float>("values");
+
+    rt::Struct outer("Outer");
+    outer.add_member<std::string>("name");
+    outer.add_member("inner", inner);
+
+    rt::Data data(outer);
+    Outer compiled = Outer();
+
+    rt::Accessor<float> values = outer.path<float>("inner.values");
+
+    bench::report("raw struct field write + read", bench::measure(iterations, [&](size_t i)
+    {
+        compiled.inner.values = static_cast<float>(i);
+        bench::do_not_optimize(compiled.inner.values);
+    }));
+
+    bench::report("accessor write + read", bench::measure(iterations, [&](size_t i)
+    {
+        values.get_mut(data) = static_cast<float>(i);
+        bench::do_not_optimize(values.get(data));
+    }));
+
+    bench::report("operator[] write + read", bench::measure(iterations, [&](size_t i)
+    {
+        data["inner"]["values"].set(static_cast<float>(i));
+        bench::do_not_optimize(data["inner"]["values"].get<float>());
+    }));
+
+    bench::report("at(path) write + read", bench::measure(iterations, [&](size_t i)
+    {
+        data.at("inner.values").set(static_cast<float>(i));
+        bench::do_not_optimize(data.at("inner.values").get<float>());
+    }));
+
+    // An accessor of a struct used on its nested snapshot checks the equivalence of both definitions.
+    rt::Struct wide("Wide");
+    for(int i = 0; i < 200; i++)
+    {
+        wide.add_member<int>("member " + std::to_string(i), i);
+    }
+    rt::Struct holder("Holder");
+    holder.add_member("wide", wide);
+    rt::Data held(holder);
+    rt::Accessor<int> last = wide.path<int>("member 199");
+
+    bench::report("accessor read on nested snapshot, 200 members", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(last.get(held["wide"]));
+    }));
+
+    // Deep nesting: one lookup per level with operator[], a single one with at().
+    std::vector<rt::Struct> levels(6);
+    levels[0].add_member<int>("value");
+    for(size_t level = 1; level < levels.size(); level++)
+    {
+        levels[level].add_member<int>("padding");
+        levels[level].add_member("level", levels[level - 1]);
+    }
+    rt::Data deep(levels.back());
+
+    bench::report("operator[] read, 5 nested levels", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(deep["level"]["level"]["level"]["level"]["level"]["value"].get<int>());
+    }));
+
+    bench::report("at(path) read, 5 nested levels", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(deep.at("level.level.level.level.level.value").get<int>());
+    }));
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+#include <vector>
+
+const size_t RECORDS = 1000;
+
+// Records of a request: all created, then all destroyed together.
+void benchmark_request(const std::string& name, const rt::Struct& type)
+{
+    const size_t iterations = 2000;
+
+    std::vector<rt::Data> records;
+    records.reserve(RECORDS);
+    bench::report(name + ", heap allocator", bench::measure(iterations, [&](size_t)
+    {
+        for(size_t i = 0; i < RECORDS; i++)
+        {
+            records.emplace_back(type);
+        }
+        bench::do_not_optimize(records.back().memory());
+        records.clear();
+    }) / RECORDS);
+
+    rt::PoolAllocator& pool = rt::PoolAllocator::instance();
+    bench::report(name + ", pool allocator", bench::measure(iterations, [&](size_t)
+    {
+        for(size_t i = 0; i < RECORDS; i++)
+        {
+            records.emplace_back(type, pool);
+        }
+        bench::do_not_optimize(records.back().memory());
+        records.clear();
+    }) / RECORDS);
+
+    rt::Arena arena;
+    bench::report(name + ", arena", bench::measure(iterations, [&](size_t)
+    {
+        for(size_t i = 0; i < RECORDS; i++)
+        {
+            bench::do_not_optimize(arena.create(type).memory());
+        }
+        arena.release();
+    }) / RECORDS);
+}
+
+int main()
+{
+    rt::Struct point("point");
+    point.add_member<double>("x", 1.0);
+    point.add_member<double>("y", 2.0);
+
+    // Both records are larger than Data::INLINE_SIZE, so the heap allocator does allocate them.
+    rt::Struct trivial("trivial");
+    trivial.add_member<uint64_t>("id", 1);
+    trivial.add_member<uint32_t>("flags", 0);
+    trivial.add_member("position", point);
+    trivial.add_member("velocity", point);
+    trivial.add_member("acceleration", point);
+    trivial.add_member<float>("value", 0.5f);
+
+    rt::Struct mixed("mixed");
+    mixed.add_member<uint64_t>("id", 1);
+    mixed.add_member<std::string>("name", "record");
+    mixed.add_member("position", point);
+    mixed.add_member("velocity", point);
+
+    benchmark_request("trivial record", trivial);
+    benchmark_request("mixed record", mixed);
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+#ifndef RT__BENCHMARK_HPP_
+#define RT__BENCHMARK_HPP_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace bench
+{
+
+/// Prevents the compiler from optimizing away the computation of 'value'.
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+/// Returns the mean time in nanoseconds of each call to 'f'.
+template <typename F>
+double measure(size_t iterations, F&& f)
+{
+    for(size_t i = 0; i < iterations / 10; i++) // warm up
+    {
+        f(i);
+    }
+
+    auto begin = std::chrono::steady_clock::now();
+    for(size_t i = 0; i < iterations; i++)
+    {
+        f(i);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double, std::nano>(end - begin).count() / iterations;
+}
+
+inline void report(const std::string& name, double ns)
+{
+    std::printf("%-48s %10.2f ns\n", name.c_str(), ns);
+}
+
+} //namespace bench
+
+#endif //RT__BENCHMARK_HPP_
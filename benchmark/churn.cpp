@@ -0,0 +1,53 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <vector>
+
+// Short-lived records: created, used and destroyed in small batches.
+void benchmark_churn(const std::string& name, const rt::Struct& type, rt::Allocator& allocator)
+{
+    const size_t iterations = 200000;
+    const size_t batch = 16;
+
+    std::vector<rt::Data> records;
+    records.reserve(batch);
+    bench::report(name, bench::measure(iterations, [&](size_t)
+    {
+        for(size_t i = 0; i < batch; i++)
+        {
+            records.emplace_back(type, allocator);
+        }
+        bench::do_not_optimize(records.back().memory());
+        records.clear();
+    }) / batch);
+}
+
+int main()
+{
+    rt::Struct point("point");
+    point.add_member<double>("x", 1.0);
+    point.add_member<double>("y", 2.0);
+
+    // Larger than Data::INLINE_SIZE, so the heap allocator does allocate each record.
+    rt::Struct record("record");
+    record.add_member<uint64_t>("id", 1);
+    record.add_member<uint32_t>("flags", 0);
+    record.add_member("position", point);
+    record.add_member("velocity", point);
+    record.add_member("acceleration", point);
+    record.add_member<float>("value", 0.5f);
+
+    rt::PoolAllocator& pool = rt::PoolAllocator::instance();
+
+    benchmark_churn("record churn, heap allocator", record, rt::HeapAllocator::instance());
+
+    pool.reset_stats();
+    benchmark_churn("record churn, pool allocator", record, pool);
+
+    rt::PoolAllocator::Stats stats = pool.stats();
+    std::printf("pool hits: %zu, misses: %zu\n", stats.hits, stats.misses);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+// Construction as done before the default image: every member built one by one.
+void build_member_by_member(const rt::Type& type, uint8_t* location)
+{
+    if(type.kind() == rt::Kind::Struct)
+    {
+        for(auto&& member: static_cast<const rt::Struct&>(type).members())
+        {
+            build_member_by_member(member.type(), location + member.offset());
+        }
+    }
+    else
+    {
+        type.build_object_at(location);
+    }
+}
+
+void benchmark_construction(const std::string& name, const rt::Struct& type)
+{
+    const size_t iterations = 2000000;
+    rt::HeapAllocator& allocator = rt::HeapAllocator::instance();
+
+    bench::report(name + ", member by member", bench::measure(iterations, [&](size_t)
+    {
+        uint8_t* memory = allocator.allocate(type.memory_size(), type.alignment());
+        build_member_by_member(type, memory);
+        bench::do_not_optimize(memory);
+        type.destroy_object_at(memory);
+        allocator.deallocate(memory, type.memory_size(), type.alignment());
+    }));
+
+    // As a Data built before the inline storage.
+    bench::report(name + ", prototype on the heap", bench::measure(iterations, [&](size_t)
+    {
+        uint8_t* memory = allocator.allocate(type.memory_size(), type.alignment());
+        type.build_object_at(memory);
+        bench::do_not_optimize(memory);
+        type.destroy_object_at(memory);
+        allocator.deallocate(memory, type.memory_size(), type.alignment());
+    }));
+
+    bench::report(name + ", prototype", bench::measure(iterations, [&](size_t)
+    {
+        rt::Data data(type);
+        bench::do_not_optimize(data.memory());
+    }));
+
+    rt::Data original(type);
+    bench::report(name + ", copy", bench::measure(iterations, [&](size_t)
+    {
+        rt::Data copy(original);
+        bench::do_not_optimize(copy.memory());
+    }));
+}
+
+int main()
+{
+    rt::Struct point("point");
+    point.add_member<double>("x", 1.0);
+    point.add_member<double>("y", 2.0);
+    point.add_member<double>("z", 3.0);
+
+    rt::Struct trivial("trivial");
+    trivial.add_member<uint64_t>("id", 1);
+    trivial.add_member<uint32_t>("flags", 0);
+    trivial.add_member<float>("value", 0.5f);
+    trivial.add_member("begin", point);
+    trivial.add_member("end", point);
+
+    rt::Struct mixed("mixed");
+    mixed.add_member<uint64_t>("id", 1);
+    mixed.add_member<std::string>("name", "record");
+    mixed.add_member<uint32_t>("flags", 0);
+    mixed.add_member<float>("value", 0.5f);
+    mixed.add_member("begin", point);
+    mixed.add_member("end", point);
+
+    // Non trivial members spread among nested levels.
+    rt::Struct label("label");
+    label.add_member<uint32_t>("id", 1);
+    label.add_member<std::string>("text", "label");
+
+    rt::Struct labeled_point("labeled_point");
+    labeled_point.add_member("point", point);
+    labeled_point.add_member("label", label);
+
+    rt::Struct nested("nested");
+    nested.add_member<uint64_t>("id", 1);
+    nested.add_member("begin", labeled_point);
+    nested.add_member("middle", labeled_point);
+    nested.add_member("end", labeled_point);
+
+    rt::Struct small("small");
+    small.add_member<uint64_t>("id", 1);
+    small.add_member("position", point);
+
+    benchmark_construction("small struct", small);
+    benchmark_construction("trivial struct", trivial);
+    benchmark_construction("mixed struct", mixed);
+    benchmark_construction("nested struct", nested);
+
+    return 0;
+}
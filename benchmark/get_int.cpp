@@ -0,0 +1,35 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+int main()
+{
+    const size_t iterations = 100000000;
+
+    rt::CType<int> type(5);
+    rt::Data data(type);
+    const rt::ReadableDataRef& ref = data;
+
+    bench::report("get<int> (type id check)", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(ref.get<int>());
+    }));
+
+    bench::report("get_unchecked<int>", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(ref.get_unchecked<int>());
+    }));
+
+    // Check as done before the type ids: typeid hash comparison.
+    bench::report("typeid hash check + read", bench::measure(iterations, [&](size_t)
+    {
+        if(ref.type().kind() != rt::Kind::CType
+            || typeid(int).hash_code() != static_cast<const rt::CType<int>&>(ref.type()).hash_code())
+        {
+            throw rt::DataAccessException("Type mismatch");
+        }
+        bench::do_not_optimize(*reinterpret_cast<const int*>(ref.memory()));
+    }));
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+#include <map>
+
+void benchmark_lookup(size_t member_count)
+{
+    const size_t iterations = 10000000;
+
+    rt::Struct s("lookup");
+    std::map<std::string, size_t> map; //Previous member container as reference
+    std::vector<std::string> names;
+    std::vector<rt::Symbol> symbols;
+    for(size_t i = 0; i < member_count; i++)
+    {
+        names.push_back("member_with_a_long_name_" + std::to_string(i));
+        symbols.emplace_back(names.back());
+        s.add_member<int>(names.back());
+        map.emplace(names.back(), i);
+    }
+
+    const std::string count = std::to_string(member_count);
+
+    bench::report("Struct::member, " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(s.member(names[i % member_count]));
+    }));
+
+    bench::report("Struct::member (symbol), " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(s.member(symbols[i % member_count]));
+    }));
+
+    bench::report("std::map::find, " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(map.find(names[i % member_count]));
+    }));
+
+    bench::report("Struct copy, " + count + " members", bench::measure(iterations / member_count / 10, [&](size_t)
+    {
+        rt::Struct copy(s);
+        bench::do_not_optimize(copy.memory_size());
+    }));
+
+    rt::Data data(s);
+    const std::string missing = "missing_member_with_a_long_name";
+    bench::report("Data::find miss, " + count + " members", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(static_cast<bool>(data.find(missing)));
+    }));
+
+    bench::report("Data::operator[] miss (exception), " + count + " members", bench::measure(iterations / 100, [&](size_t)
+    {
+        try
+        {
+            bench::do_not_optimize(data[missing].memory());
+        }
+        catch(const rt::MemberAccessException&)
+        {
+            bench::do_not_optimize(data.memory());
+        }
+    }));
+
+    bench::report("Data copy, " + count + " members", bench::measure(iterations / member_count, [&](size_t)
+    {
+        rt::Data copy(data);
+        bench::do_not_optimize(copy.memory());
+    }));
+}
+
+int main()
+{
+    benchmark_lookup(4);
+    benchmark_lookup(32);
+    benchmark_lookup(512);
+
+    return 0;
+}
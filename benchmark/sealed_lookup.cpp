@@ -0,0 +1,61 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+#include <chrono>
+#include <map>
+
+void benchmark_sealed_lookup(size_t member_count)
+{
+    const size_t iterations = 10000000;
+
+    rt::Struct open_struct("open");
+    rt::Struct sealed_struct("sealed");
+    std::map<std::string, size_t> map; //Previous member container as reference
+    std::vector<std::string> names;
+    for(size_t i = 0; i < member_count; i++)
+    {
+        names.push_back("member_with_a_long_name_" + std::to_string(i));
+        open_struct.add_member<int>(names.back());
+        sealed_struct.add_member<int>(names.back());
+        map.emplace(names.back(), i);
+    }
+
+    const std::string count = std::to_string(member_count);
+
+    auto start = std::chrono::steady_clock::now();
+    sealed_struct.seal();
+    auto seal_time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    bench::report("seal (once), " + count + " members", seal_time);
+
+    bench::report("std::map::find, " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(map.find(names[i % member_count]));
+    }));
+
+    bench::report("Struct::member, " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(open_struct.member(names[i % member_count]));
+    }));
+
+    bench::report("Sealed Struct::member, " + count + " members", bench::measure(iterations, [&](size_t i)
+    {
+        bench::do_not_optimize(sealed_struct.member(names[i % member_count]));
+    }));
+
+    const std::string missing = "missing_member_with_a_long_name";
+    bench::report("Sealed Struct::member miss, " + count + " members", bench::measure(iterations, [&](size_t)
+    {
+        bench::do_not_optimize(sealed_struct.member(missing));
+    }));
+}
+
+int main()
+{
+    benchmark_sealed_lookup(10);
+    benchmark_sealed_lookup(100);
+    benchmark_sealed_lookup(1000);
+    benchmark_sealed_lookup(10000);
+
+    return 0;
+}
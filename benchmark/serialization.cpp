@@ -0,0 +1,45 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+int main()
+{
+    const size_t iterations = 2000000;
+
+    rt::Struct point("point");
+    point.add_member<double>("x", 1.0);
+    point.add_member<double>("y", 2.0);
+
+    rt::Struct record("record");
+    record.add_member<uint64_t>("id", 1);
+    record.add_member<uint32_t>("flags", 3);
+    record.add_member<float>("value", 0.5f);
+    record.add_member("begin", point);
+    record.add_member("end", point);
+    record.add_member<std::string>("name", "a record name");
+    record.add_member<std::vector<int>>("samples", std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8});
+
+    rt::Data data(record);
+    rt::Data read(record);
+    rt::Buffer buffer;
+
+    rt::serialize(data, buffer);
+    const size_t record_size = buffer.size();
+    buffer.reserve(record_size);
+
+    bench::report("serialize record (" + std::to_string(record_size) + " bytes)", bench::measure(iterations, [&](size_t)
+    {
+        buffer.clear();
+        rt::serialize(data, buffer);
+        bench::do_not_optimize(buffer.data());
+    }));
+
+    bench::report("deserialize record", bench::measure(iterations, [&](size_t)
+    {
+        buffer.rewind();
+        rt::deserialize(read, buffer);
+        bench::do_not_optimize(read.memory());
+    }));
+
+    return 0;
+}
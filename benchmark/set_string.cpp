@@ -0,0 +1,65 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> allocations(0);
+
+void* operator new(size_t size)
+{
+    allocations++;
+    if(void* memory = std::malloc(size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    const size_t iterations = 1000000;
+    const double calls = iterations * 1.1; // bench::measure also runs iterations / 10 warm up calls
+
+    rt::Struct record("record");
+    record.add_member<int>("id");
+    record.add_member<std::string>("name");
+
+    rt::Data data(record);
+    const std::string values[] = {
+        std::string(40, 'a'),
+        std::string(60, 'b'),
+        std::string(50, 'c'),
+    };
+
+    // Update as done before: the old value is destroyed and the new one copy constructed.
+    allocations = 0;
+    double ns = bench::measure(iterations, [&](size_t i)
+    {
+        std::string& name = data["name"].get_mut<std::string>();
+        name.~basic_string();
+        new (&name) std::string(values[i % 3]);
+    });
+    bench::report("destroy + copy construct, " + std::to_string(allocations / calls) + " allocs/set", ns);
+
+    allocations = 0;
+    ns = bench::measure(iterations, [&](size_t i)
+    {
+        data["name"].set(values[i % 3]);
+    });
+    bench::report("set (assignment), " + std::to_string(allocations / calls) + " allocs/set", ns);
+
+    return 0;
+}
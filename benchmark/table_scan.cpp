@@ -0,0 +1,65 @@
+#include <runtypes/runtypes.hpp>
+
+#include "benchmark.hpp"
+
+int main()
+{
+    const size_t rows = 1000000;
+    const size_t iterations = 50;
+
+    rt::Struct record("record");
+    record.add_member<uint64_t>("id");
+    record.add_member<std::string>("name");
+    record.add_member<float>("value");
+    record.add_member<double>("x");
+    record.add_member<double>("y");
+
+    rt::Table table(record);
+    rt::DataArray array(record);
+    std::vector<float> raw;
+
+    table.resize(rows);
+    array.resize(rows);
+    raw.resize(rows);
+
+    rt::Column<float> column = table.column<float>("value");
+    rt::Accessor<float> value = record.path<float>("value");
+    for(size_t i = 0; i < rows; i++)
+    {
+        column[i] = static_cast<float>(i % 100);
+        value.set(array[i], static_cast<float>(i % 100));
+        raw[i] = static_cast<float>(i % 100);
+    }
+
+    bench::report("std::vector<float> scan, per row", bench::measure(iterations, [&](size_t)
+    {
+        float sum = 0;
+        for(float v: raw)
+        {
+            sum += v;
+        }
+        bench::do_not_optimize(sum);
+    }) / rows);
+
+    bench::report("table column scan, per row", bench::measure(iterations, [&](size_t)
+    {
+        float sum = 0;
+        for(float v: table.column<float>("value"))
+        {
+            sum += v;
+        }
+        bench::do_not_optimize(sum);
+    }) / rows);
+
+    bench::report("data array rows scan, per row", bench::measure(iterations, [&](size_t)
+    {
+        float sum = 0;
+        for(size_t i = 0; i < array.size(); i++)
+        {
+            sum += value.get(array[i]);
+        }
+        bench::do_not_optimize(sum);
+    }) / rows);
+
+    return 0;
+}
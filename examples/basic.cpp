@@ -1,6 +1,7 @@
 #include <runtypes/runtypes.hpp>
 
 #include <iostream>
+#include <map>
 
 int main()
 {
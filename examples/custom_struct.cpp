@@ -21,6 +21,13 @@ struct A
         std::cout << INDENT_STR << "+ Copy: " << c_ << "º, address: " << reinterpret_cast<uintptr_t>(this) << std::endl;
     };
 
+    A& operator=(const A& other)
+    {
+        value_ = other.value_;
+        std::cout << INDENT_STR << "= Assign: " << c_ << "º, address: " << reinterpret_cast<uintptr_t>(this) << std::endl;
+        return *this;
+    };
+
     ~A()
     {
         std::cout << INDENT_STR << "- Destroy: " << c_ << "º, address: " << reinterpret_cast<uintptr_t>(this) << std::endl;
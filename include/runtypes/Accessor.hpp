@@ -0,0 +1,124 @@
+#ifndef RT__ACCESSOR_HPP_
+#define RT__ACCESSOR_HPP_
+
+#include <runtypes/Data.hpp>
+#include <runtypes/Exception.hpp>
+
+namespace rt
+{
+
+//=========================== Accessor =============================
+/// Member access resolved once from a dotted path ("inner.values").
+/// The path lookups and the type checks are done at construction,
+/// later accesses only add the precomputed offset to the data memory.
+/// The accessor must be created once the struct definition has finished.
+template <typename T>
+class Accessor
+{
+public:
+    Accessor(const Struct& root, const std::string& path)
+        : root_(&root)
+        , offset_(0)
+    {
+        const MemberPath* member = root.member_path(path);
+        if(!member)
+        {
+            throw_path_error(root, path);
+        }
+
+        offset_ = member->offset;
+        const Type* type = member->type;
+        if(type->kind() != Kind::CType)
+        {
+            throw DataAccessException("Accessor can only be created to members with primitive types. "
+                   "Path '" + path + "' leads to type '" + type->name() + "'.");
+        }
+
+        if(!type->is<T>())
+        {
+            throw DataAccessException("Type '" + type->name() + "' differs from '" + typeid(T).name() + "'.");
+        }
+    }
+
+    const Struct& root() const { return *root_; }
+    size_t offset() const { return offset_; }
+
+    const T& get(const ReadableDataRef& data) const
+    {
+        validate_root(data);
+        return *reinterpret_cast<const T*>(data.memory() + offset_);
+    }
+
+    T& get_mut(WritableDataRef& data) const
+    {
+        validate_root(data);
+        return *reinterpret_cast<T*>(data.memory() + offset_);
+    }
+
+    T& get_mut(WritableDataRef&& data) const
+    {
+        return get_mut(data);
+    }
+
+    /// Assigns as WritableDataRef::set does.
+    void set(WritableDataRef& data, const T& t) const
+    {
+        assign_value(get_mut(data), t);
+    }
+
+    void set(WritableDataRef&& data, const T& t) const
+    {
+        assign_value(get_mut(data), t);
+    }
+
+private:
+    // Walks the path to report the name that can not be resolved.
+    static void throw_path_error(const Struct& root, const std::string& path)
+    {
+        const Type* type = &root;
+        size_t begin = 0;
+        while(begin <= path.size())
+        {
+            size_t end = std::min(path.find('.', begin), path.size());
+            std::string name = path.substr(begin, end - begin);
+
+            if(type->kind() != Kind::Struct)
+            {
+                throw MemberAccessException("Type '" + type->name() + "' has no members.");
+            }
+
+            const Member* member = static_cast<const Struct*>(type)->member(name);
+            if(!member)
+            {
+                throw MemberAccessException("Type '" + type->name() + "' has no member '" + name + "'.");
+            }
+
+            type = &member->type();
+            begin = end + 1;
+        }
+
+        throw MemberAccessException("Type '" + root.name() + "' has no member path '" + path + "'.");
+    }
+
+    void validate_root(const ReadableDataRef& data) const
+    {
+        if(!root_->equivalent(data.type()))
+        {
+            throw DataAccessException("Accessor from type " + root_->display_name() + " "
+                   "can not be used with data of type " + data.type().display_name() + ".");
+        }
+    }
+
+    const Struct* root_;
+    size_t offset_;
+};
+
+template <typename T>
+Accessor<T> Struct::path(const std::string& path) const
+{
+    return Accessor<T>(*this, path);
+}
+
+} //namespace rt
+
+#endif //RT__ACCESSOR_HPP_
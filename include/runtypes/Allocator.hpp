@@ -0,0 +1,162 @@
+#ifndef RT__ALLOCATOR_HPP_
+#define RT__ALLOCATOR_HPP_
+
+#include <runtypes/Type.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+namespace rt
+{
+
+//=========================== Allocator =============================
+/// Memory provider of the Data instances.
+class Allocator
+{
+public:
+    virtual ~Allocator() = default;
+
+    virtual uint8_t* allocate(size_t size, size_t alignment) = 0;
+    virtual void deallocate(uint8_t* memory, size_t size, size_t alignment) = 0;
+};
+
+//=========================== HeapAllocator =============================
+/// Default allocator, based on the global operator new.
+class HeapAllocator : public Allocator
+{
+public:
+    static HeapAllocator& instance()
+    {
+        static HeapAllocator allocator;
+        return allocator;
+    }
+
+    // operator new only guarantees the alignment of std::max_align_t.
+    // Over-aligned types reserve extra space and keep the original pointer just before the object.
+    virtual uint8_t* allocate(size_t size, size_t alignment) override
+    {
+        if(alignment <= alignof(std::max_align_t))
+        {
+            return static_cast<uint8_t*>(::operator new(size));
+        }
+
+        uint8_t* raw = static_cast<uint8_t*>(::operator new(size + alignment + sizeof(void*)));
+        uintptr_t address = align_up(reinterpret_cast<uintptr_t>(raw) + sizeof(void*), alignment);
+        uint8_t* memory = reinterpret_cast<uint8_t*>(address);
+        reinterpret_cast<void**>(memory)[-1] = raw;
+        return memory;
+    }
+
+    virtual void deallocate(uint8_t* memory, size_t, size_t alignment) override
+    {
+        if(alignment <= alignof(std::max_align_t))
+        {
+            ::operator delete(memory);
+        }
+        else
+        {
+            ::operator delete(reinterpret_cast<void**>(memory)[-1]);
+        }
+    }
+};
+
+//=========================== AlignedBuffer =============================
+/// Zero initialized heap memory with a custom alignment. The content is copied bitwise,
+/// so it only can hold trivially copyable objects.
+class AlignedBuffer
+{
+public:
+    AlignedBuffer()
+        : memory_(nullptr)
+        , size_(0)
+        , capacity_(0)
+        , alignment_(1)
+    {}
+
+    AlignedBuffer(const AlignedBuffer& other)
+        : AlignedBuffer()
+    {
+        resize(other.size_, other.alignment_);
+        if(size_ > 0)
+        {
+            std::memcpy(memory_, other.memory_, size_);
+        }
+    }
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : AlignedBuffer()
+    {
+        swap(other);
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~AlignedBuffer()
+    {
+        if(memory_)
+        {
+            HeapAllocator::instance().deallocate(memory_, capacity_, alignment_);
+        }
+    }
+
+    void swap(AlignedBuffer& other) noexcept
+    {
+        std::swap(memory_, other.memory_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(alignment_, other.alignment_);
+    }
+
+    /// Keeps the current content. The new bytes are zero.
+    void resize(size_t size, size_t alignment)
+    {
+        if(size > capacity_ || alignment > alignment_)
+        {
+            size_t capacity = std::max(size, capacity_ * 2);
+            alignment = std::max(alignment, alignment_);
+            uint8_t* memory = HeapAllocator::instance().allocate(capacity, alignment);
+            std::memset(memory, 0, capacity);
+            if(memory_)
+            {
+                std::memcpy(memory, memory_, std::min(size, size_));
+                HeapAllocator::instance().deallocate(memory_, capacity_, alignment_);
+            }
+            memory_ = memory;
+            capacity_ = capacity;
+            alignment_ = alignment;
+        }
+        else if(size < size_)
+        {
+            std::memset(memory_ + size, 0, size_ - size);
+        }
+        size_ = size;
+    }
+
+    void clear()
+    {
+        if(size_ > 0)
+        {
+            std::memset(memory_, 0, size_);
+        }
+    }
+
+    uint8_t* data() { return memory_; }
+    const uint8_t* data() const { return memory_; }
+    size_t size() const { return size_; }
+
+private:
+    uint8_t* memory_;
+    size_t size_;
+    size_t capacity_;
+    size_t alignment_;
+};
+
+} //namespace rt
+
+#endif //RT__ALLOCATOR_HPP_
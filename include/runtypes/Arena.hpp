@@ -0,0 +1,148 @@
+#ifndef RT__ARENA_HPP_
+#define RT__ARENA_HPP_
+
+#include <runtypes/Data.hpp>
+#include <runtypes/Allocator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace rt
+{
+
+//=========================== Arena =============================
+/// Allocator for batches of instances that die together, as the records of a request.
+/// The memory is taken from chunks by moving a pointer, and it is never released one by one:
+/// release() destroys all the instances and makes the chunks available again for the next batch.
+///
+/// The instances created by create() are destroyed by release(). Only the instances
+/// of types not trivially destructible are tracked, so their types must outlive the release().
+class Arena : public Allocator
+{
+public:
+    explicit Arena(size_t chunk_size = 4096)
+        : current_(0)
+        , chunk_used_(0)
+        , used_(0)
+        , next_chunk_size_(chunk_size)
+        , finalizers_(nullptr)
+    {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    virtual ~Arena()
+    {
+        release();
+        for(auto&& chunk: chunks_)
+        {
+            HeapAllocator::instance().deallocate(chunk.memory, chunk.size, alignof(std::max_align_t));
+        }
+    }
+
+    virtual uint8_t* allocate(size_t size, size_t alignment) override
+    {
+        while(current_ < chunks_.size())
+        {
+            Chunk& chunk = chunks_[current_];
+            uintptr_t base = reinterpret_cast<uintptr_t>(chunk.memory);
+            size_t offset = align_up(base + chunk_used_, alignment) - base;
+            if(offset + size <= chunk.size)
+            {
+                used_ += offset + size - chunk_used_;
+                chunk_used_ = offset + size;
+                return chunk.memory + offset;
+            }
+
+            current_++;
+            chunk_used_ = 0;
+        }
+
+        add_chunk(size + alignment);
+        return allocate(size, alignment);
+    }
+
+    /// The memory is only released by release().
+    virtual void deallocate(uint8_t*, size_t, size_t) override {}
+
+    /// Builds an instance of 'type' in the arena, that lives until release().
+    DataView create(const Type& type)
+    {
+        uint8_t* memory = allocate(type.memory_size(), type.alignment());
+        type.build_object_at(memory);
+        if(!type.is_trivially_destructible())
+        {
+            uint8_t* location = allocate(sizeof(Finalizer), alignof(Finalizer));
+            finalizers_ = new (location) Finalizer{finalizers_, &type, memory};
+        }
+        return DataView(type, memory);
+    }
+
+    /// Destroys the instances created by create() in reverse creation order.
+    /// The chunks are kept for the next allocations.
+    void release()
+    {
+        for(Finalizer* finalizer = finalizers_; finalizer; finalizer = finalizer->next)
+        {
+            finalizer->type->destroy_object_at(finalizer->object);
+        }
+        finalizers_ = nullptr;
+        current_ = 0;
+        chunk_used_ = 0;
+        used_ = 0;
+    }
+
+    /// Bytes taken since the last release, alignment padding included.
+    size_t used() const { return used_; }
+
+    /// Bytes of all the chunks.
+    size_t capacity() const
+    {
+        size_t capacity = 0;
+        for(auto&& chunk: chunks_)
+        {
+            capacity += chunk.size;
+        }
+        return capacity;
+    }
+
+private:
+    struct Chunk
+    {
+        uint8_t* memory;
+        size_t size;
+    };
+
+    // Placed in the arena next to the instance it destroys.
+    struct Finalizer
+    {
+        Finalizer* next;
+        const Type* type;
+        uint8_t* object;
+    };
+
+    // Chunks double their size up to 1 MiB, bigger requests take a chunk of their own size.
+    void add_chunk(size_t min_size)
+    {
+        const size_t size = std::max(next_chunk_size_, min_size);
+        chunks_.push_back(Chunk{HeapAllocator::instance().allocate(size, alignof(std::max_align_t)), size});
+        if(next_chunk_size_ < (size_t(1) << 20))
+        {
+            next_chunk_size_ *= 2;
+        }
+        current_ = chunks_.size() - 1;
+        chunk_used_ = 0;
+    }
+
+    std::vector<Chunk> chunks_;
+    size_t current_; //Chunk in use
+    size_t chunk_used_; //Bytes taken from the chunk in use
+    size_t used_;
+    size_t next_chunk_size_;
+    Finalizer* finalizers_; //Last created instance first
+};
+
+} //namespace rt
+
+#endif //RT__ARENA_HPP_
@@ -0,0 +1,102 @@
+#ifndef RT__ARRAY_HPP_
+#define RT__ARRAY_HPP_
+
+#include <runtypes/Type.hpp>
+
+#include <cstring>
+
+namespace rt
+{
+
+//=========================== ARRAY =============================
+/// Fixed number of elements of the same type, placed back to back.
+class Array : public Type
+{
+public:
+    Array(const Type& element, size_t size)
+        : Type(Kind::Array, NO_TYPE_ID, element.name() + "[" + std::to_string(size) + "]",
+            align_up(element.memory_size(), element.alignment()) * size, element.alignment(),
+            element.is_trivially_copyable(), element.is_trivially_destructible(), element.is_nothrow_movable())
+        , element_(TypeRef::share(element))
+        , size_(size)
+        , stride_(align_up(element.memory_size(), element.alignment()))
+    {
+        for(size_t i = 0; i < size_; i++)
+        {
+            serial_plan_.append(element.serial_plan(), i * stride_);
+        }
+        fingerprint_ = mix_fingerprint(mix_fingerprint(fingerprint_, element.fingerprint()), size_);
+    }
+
+    virtual ~Array() = default;
+
+    virtual std::unique_ptr<Type> clone() const override
+    {
+        return std::unique_ptr<Type>(new Array(*this));
+    }
+
+    virtual void build_object_at(uint8_t* location) const override
+    {
+        for(size_t i = 0; i < size_; i++)
+        {
+            element_->build_object_at(location + i * stride_);
+        }
+    }
+
+    virtual void destroy_object_at(uint8_t* location) const override
+    {
+        if(trivially_destructible_)
+        {
+            return;
+        }
+
+        for(size_t i = size_; i > 0; i--)
+        {
+            element_->destroy_object_at(location + (i - 1) * stride_);
+        }
+    }
+
+    virtual void copy_object(uint8_t* dest_location, uint8_t* src_location) const override
+    {
+        if(trivially_copyable_)
+        {
+            if(memory_size_ > 0)
+            {
+                std::memcpy(dest_location, src_location, memory_size_);
+            }
+            return;
+        }
+
+        for(size_t i = 0; i < size_; i++)
+        {
+            element_->copy_object(dest_location + i * stride_, src_location + i * stride_);
+        }
+    }
+
+    virtual void move_object(uint8_t* dest_location, uint8_t* src_location) const override
+    {
+        if(trivially_copyable_)
+        {
+            copy_object(dest_location, src_location);
+            return;
+        }
+
+        for(size_t i = 0; i < size_; i++)
+        {
+            element_->move_object(dest_location + i * stride_, src_location + i * stride_);
+        }
+    }
+
+    const Type& element() const { return *element_; }
+    size_t size() const { return size_; }
+    size_t stride() const { return stride_; }
+
+private:
+    TypeRef element_; //Shared with the copies
+    size_t size_;
+    size_t stride_;
+};
+
+} //namespace rt
+
+#endif //RT__ARRAY_HPP_
@@ -3,7 +3,10 @@
 
 #include <runtypes/Type.hpp>
 #include <runtypes/Exception.hpp>
+#include <runtypes/Codec.hpp>
 
+#include <cstddef>
+#include <new>
 #include <typeinfo>
 #include <type_traits>
 
@@ -20,31 +23,52 @@ class CType : public Type
 {
 public:
     CType(const CType& other)
-        : Type(Kind::CType, typeid(T).name(), sizeof(T))
+        : Type(Kind::CType, type_id<T>(), typeid(T).name(), sizeof(T), alignof(T),
+            std::is_trivially_copyable<T>::value, std::is_trivially_destructible<T>::value,
+            std::is_nothrow_move_constructible<T>::value)
         , hash_code_(typeid(T).hash_code())
-        , base_instance_(other.base_instance_)
+        , base_instance_(new (storage()) T(*other.base_instance_))
     {
         static_assert(std::is_copy_constructible<T>::value, RT_NO_COPY_CONSTRUCTIBLE_ERROR(T));
+        serial_plan_ = make_serial_plan<T>();
     };
 
     CType(const T& t)
-        : Type(Kind::CType, typeid(T).name(), sizeof(T))
+        : Type(Kind::CType, type_id<T>(), typeid(T).name(), sizeof(T), alignof(T),
+            std::is_trivially_copyable<T>::value, std::is_trivially_destructible<T>::value,
+            std::is_nothrow_move_constructible<T>::value)
         , hash_code_(typeid(T).hash_code())
-        , base_instance_(t)
+        , base_instance_(new (storage()) T(t))
     {
         static_assert(std::is_copy_constructible<T>::value, RT_NO_COPY_CONSTRUCTIBLE_ERROR(T));
+        serial_plan_ = make_serial_plan<T>();
     };
 
     template<typename... Args>
     CType(Args&&... args)
-        : Type(Kind::CType, typeid(T).name(), sizeof(T))
+        : Type(Kind::CType, type_id<T>(), typeid(T).name(), sizeof(T), alignof(T),
+            std::is_trivially_copyable<T>::value, std::is_trivially_destructible<T>::value,
+            std::is_nothrow_move_constructible<T>::value)
         , hash_code_(typeid(T).hash_code())
-        , base_instance_(std::forward<Args>(args)...)
+        , base_instance_(new (storage()) T(std::forward<Args>(args)...))
     {
         static_assert(std::is_copy_constructible<T>::value, RT_NO_COPY_CONSTRUCTIBLE_ERROR(T));
+        serial_plan_ = make_serial_plan<T>();
     };
 
-    virtual ~CType() = default;
+    /// Assigns the default instance, that stays in the storage of this type.
+    CType& operator=(const CType& other)
+    {
+        Type::operator=(other);
+        hash_code_ = other.hash_code_;
+        *base_instance_ = *other.base_instance_;
+        return *this;
+    }
+
+    virtual ~CType()
+    {
+        base_instance_->~T();
+    }
 
     virtual std::unique_ptr<Type> clone() const override
     {
@@ -53,7 +77,7 @@ public:
 
     virtual void build_object_at(uint8_t* location) const override
     {
-        new (location) T(base_instance_);
+        new (location) T(*base_instance_);
     }
 
     virtual void destroy_object_at(uint8_t* location) const override
@@ -66,12 +90,27 @@ public:
         new (dest_location) T(*reinterpret_cast<T*>(src_location));
     }
 
+    virtual void move_object(uint8_t* dest_location, uint8_t* src_location) const override
+    {
+        new (dest_location) T(std::move(*reinterpret_cast<T*>(src_location)));
+    }
+
     size_t hash_code() const { return hash_code_; }
-    const T& base_instance() const { return base_instance_; }
+    const T& base_instance() const { return *base_instance_; }
 
 private:
-    size_t hash_code_; //Must be placed before instance
-    T base_instance_;
+    // Before C++17 operator new only guarantees the alignment of std::max_align_t,
+    // so the storage of an over-aligned default instance has room to align it.
+    static constexpr size_t STORAGE_ALIGNMENT = alignof(T) < alignof(std::max_align_t) ? alignof(T) : alignof(std::max_align_t);
+
+    uint8_t* storage()
+    {
+        return reinterpret_cast<uint8_t*>(align_up(reinterpret_cast<uintptr_t>(storage_), alignof(T)));
+    }
+
+    size_t hash_code_;
+    alignas(STORAGE_ALIGNMENT) uint8_t storage_[sizeof(T) + alignof(T) - STORAGE_ALIGNMENT];
+    T* base_instance_; //Default instance, placed in storage_
 };
 
 } //namespace rt
@@ -0,0 +1,140 @@
+#ifndef RT__CODEC_HPP_
+#define RT__CODEC_HPP_
+
+#include <runtypes/SerialPlan.hpp>
+
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace rt
+{
+
+//=========================== Codec =============================
+/// Serialization of a C++ type. Specialize it to serialize your own non trivially copyable types:
+///     static constexpr bool available = true;
+///     static void encode(const T& value, Buffer& buffer);
+///     static void decode(T& value, Buffer& buffer); // 'value' is an already built object.
+template <typename T, typename Enable = void>
+struct Codec
+{
+    static constexpr bool available = false;
+};
+
+template <typename T>
+struct Codec<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
+{
+    static constexpr bool available = true;
+
+    static void encode(const T& value, Buffer& buffer)
+    {
+        buffer.write(&value, sizeof(T));
+    }
+
+    static void decode(T& value, Buffer& buffer)
+    {
+        buffer.read(&value, sizeof(T));
+    }
+};
+
+template <>
+struct Codec<std::string>
+{
+    static constexpr bool available = true;
+
+    static void encode(const std::string& value, Buffer& buffer)
+    {
+        buffer.write_size(value.size());
+        buffer.write(value.data(), value.size());
+    }
+
+    static void decode(std::string& value, Buffer& buffer)
+    {
+        value.resize(buffer.read_count(1));
+        buffer.read(&value[0], value.size());
+    }
+};
+
+template <typename T>
+struct Codec<std::vector<T>, typename std::enable_if<Codec<T>::available && !std::is_same<T, bool>::value>::type>
+{
+    static constexpr bool available = true;
+
+    static void encode(const std::vector<T>& value, Buffer& buffer)
+    {
+        buffer.write_size(value.size());
+        if(std::is_trivially_copyable<T>::value)
+        {
+            buffer.write(value.data(), value.size() * sizeof(T));
+        }
+        else
+        {
+            for(auto&& element: value)
+            {
+                Codec<T>::encode(element, buffer);
+            }
+        }
+    }
+
+    static void decode(std::vector<T>& value, Buffer& buffer)
+    {
+        // A non trivially copyable element is encoded in one byte at least.
+        value.resize(buffer.read_count(std::is_trivially_copyable<T>::value ? sizeof(T) : 1));
+        if(std::is_trivially_copyable<T>::value)
+        {
+            buffer.read(value.data(), value.size() * sizeof(T));
+        }
+        else
+        {
+            for(auto&& element: value)
+            {
+                Codec<T>::decode(element, buffer);
+            }
+        }
+    }
+};
+
+//=========================== Serial plan of C++ types =============================
+template <typename T>
+struct CodecAdapter
+{
+    static void encode(const uint8_t* location, Buffer& buffer)
+    {
+        Codec<T>::encode(*reinterpret_cast<const T*>(location), buffer);
+    }
+
+    static void decode(uint8_t* location, Buffer& buffer)
+    {
+        Codec<T>::decode(*reinterpret_cast<T*>(location), buffer);
+    }
+
+    static const CodecFunctions functions;
+};
+
+template <typename T>
+const CodecFunctions CodecAdapter<T>::functions = {&CodecAdapter<T>::encode, &CodecAdapter<T>::decode};
+
+template <typename T>
+SerialPlan make_serial_plan(std::true_type /*codec available*/)
+{
+    return std::is_trivially_copyable<T>::value
+        ? SerialPlan::bytes(sizeof(T))
+        : SerialPlan::codec(sizeof(T), CodecAdapter<T>::functions);
+}
+
+template <typename T>
+SerialPlan make_serial_plan(std::false_type /*codec available*/)
+{
+    return SerialPlan::unsupported(sizeof(T), typeid(T).name());
+}
+
+template <typename T>
+SerialPlan make_serial_plan()
+{
+    return make_serial_plan<T>(std::integral_constant<bool, Codec<T>::available>());
+}
+
+} //namespace rt
+
+#endif //RT__CODEC_HPP_
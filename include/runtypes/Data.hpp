@@ -2,8 +2,15 @@
 #define RT__DATA_HPP_
 
 #include <runtypes/Struct.hpp>
+#include <runtypes/Allocator.hpp>
 #include <runtypes/Exception.hpp>
 
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 #define RT_NO_COPY_ASSIGNABLE_ERROR(TYPE) \
     RT_STATIC_ERROR_TAG \
     "Type '" #TYPE "' must be copy is_copy_assignable. " \
@@ -13,22 +20,90 @@
 namespace rt
 {
 
+//=========================== Assignment =============================
+template <typename T, typename V>
+void assign_value(T& current, V&& value, std::true_type /*assignable*/)
+{
+    current = std::forward<V>(value);
+}
+
+template <typename T, typename V>
+void assign_value(T& current, V&& value, std::false_type /*assignable*/)
+{
+    if(&current == &value)
+    {
+        return;
+    }
+
+    current.~T();
+    new (&current) T(std::forward<V>(value));
+}
+
+/// Assigns 'value' by T::operator= when it is available, so the resources of the current value
+/// are kept, as the capacity of a string. Otherwise the value is destroyed and rebuilt.
+template <typename T, typename V>
+void assign_value(T& current, V&& value)
+{
+    assign_value(current, std::forward<V>(value), std::is_assignable<T&, V&&>());
+}
+
 //=========================== ReadableDataRef =============================
+/// Handle to an instance: a type pointer and a memory pointer.
+/// The refs are trivially copyable and have no virtual functions, so they are passed in registers
+/// and a chained access is reduced to pointer arithmetic.
 class ReadableDataRef
 {
 public:
     ReadableDataRef(const ReadableDataRef&) = default;
-    virtual ~ReadableDataRef() = default;
+    ReadableDataRef& operator=(const ReadableDataRef&) = delete;
+    ~ReadableDataRef() = default;
 
-    const Type& type() const { return type_; }
+    const Type& type() const { return *type_; }
     const uint8_t* memory() const { return memory_; }
 
-    ReadableDataRef operator[](const std::string& name) const
+    /// False for the empty references returned by a failed 'find'.
+    explicit operator bool() const { return type_ != nullptr; }
+
+    ReadableDataRef operator[](StringView name) const
     {
         const Member* member = get_member(name);
         return ReadableDataRef(member->type(), memory_ + member->offset());
     }
 
+    /// Access by an interned name, resolved without comparing strings.
+    ReadableDataRef operator[](const Symbol& name) const
+    {
+        const Member* member = get_member(name);
+        return ReadableDataRef(member->type(), memory_ + member->offset());
+    }
+
+    ReadableDataRef operator[](size_t index) const
+    {
+        const Array& array = get_array(index);
+        return ReadableDataRef(array.element(), memory_ + index * array.stride());
+    }
+
+    /// Access to the member placed in the dotted 'path' ("inner.values"),
+    /// resolved by a single lookup instead of one per nesting level.
+    ReadableDataRef at(StringView path) const
+    {
+        const MemberPath* member = get_member_path(path);
+        return ReadableDataRef(*member->type, memory_ + member->offset);
+    }
+
+    /// As operator[], but returns an empty reference instead of throwing if there is no member 'name'.
+    ReadableDataRef find(StringView name) const
+    {
+        const Member* member = find_member(name);
+        return member ? ReadableDataRef(member->type(), memory_ + member->offset()) : ReadableDataRef();
+    }
+
+    ReadableDataRef find(const Symbol& name) const
+    {
+        const Member* member = find_member(name);
+        return member ? ReadableDataRef(member->type(), memory_ + member->offset()) : ReadableDataRef();
+    }
+
     template <typename T>
     const T& get() const
     {
@@ -44,47 +119,142 @@ public:
         t = *reinterpret_cast<T*>(memory_);
     }
 
+    /// As 'get', but returns nullptr instead of throwing if the data is not a 'T'.
+    template <typename T>
+    const T* try_get() const
+    {
+        return type_ && type_->is<T>() ? reinterpret_cast<const T*>(memory_) : nullptr;
+    }
+
+    /// As 'get', without validating the type. Only asserted in debug builds.
+    template <typename T>
+    const T& get_unchecked() const
+    {
+        assert(type_->is<T>() && "get_unchecked: type differs");
+        return *reinterpret_cast<const T*>(memory_);
+    }
+
 protected:
+    friend class DataArray;
+
     ReadableDataRef(const Type& type, uint8_t* memory)
-        : type_(type)
+        : type_(&type)
         , memory_(memory)
     {}
 
-    const Member* get_member(const std::string& name) const
+    ReadableDataRef()
+        : type_(nullptr)
+        , memory_(nullptr)
+    {}
+
+    template <typename Name>
+    const Member* find_member(const Name& name) const
     {
-        if(type_.kind() != Kind::Struct)
+        if(!type_ || type_->kind() != Kind::Struct)
         {
-            throw MemberAccessException("Type '" + type_.name() + "' has no members.");
+            return nullptr;
         }
 
-        const Member* member = static_cast<const Struct&>(type_).member(name);
+        return static_cast<const Struct&>(*type_).member(name);
+    }
+
+    template <typename Name>
+    const Member* get_member(const Name& name) const
+    {
+#ifdef RUNTYPES_UNCHECKED
+        assert(type_->kind() == Kind::Struct && static_cast<const Struct&>(*type_).member(name));
+        return static_cast<const Struct&>(*type_).member(name);
+#else
+        if(type_->kind() != Kind::Struct)
+        {
+            throw MemberAccessException("Type '" + type_->name() + "' has no members.");
+        }
+
+        const Member* member = static_cast<const Struct&>(*type_).member(name);
         if(!member)
         {
-            throw MemberAccessException("Type '" + type_.name() + "' has no member '" + name + "'.");
+            throw MemberAccessException("Type '" + type_->name() + "' has no member '" + name_of(name) + "'.");
         }
 
         return member;
+#endif
     }
 
-    template <typename T>
-    bool validate_data_type(const std::string& method) const
+    static std::string name_of(StringView name) { return name.to_string(); }
+    static const std::string& name_of(const Symbol& name) { return name.name(); }
+
+    const MemberPath* get_member_path(StringView path) const
+    {
+#ifdef RUNTYPES_UNCHECKED
+        assert(type_->kind() == Kind::Struct && static_cast<const Struct&>(*type_).member_path(path));
+        return static_cast<const Struct&>(*type_).member_path(path);
+#else
+        if(type_->kind() != Kind::Struct)
+        {
+            throw MemberAccessException("Type '" + type_->name() + "' has no members.");
+        }
+
+        const MemberPath* member = static_cast<const Struct&>(*type_).member_path(path);
+        if(!member)
+        {
+            throw MemberAccessException("Type '" + type_->name() + "' has no member path '" + path.to_string() + "'.");
+        }
+
+        return member;
+#endif
+    }
+
+    const Array& get_array(size_t index) const
     {
-        if(type_.kind() != Kind::CType)
+#ifdef RUNTYPES_UNCHECKED
+        assert(type_->kind() == Kind::Array && index < static_cast<const Array&>(*type_).size());
+        (void)index;
+        return static_cast<const Array&>(*type_);
+#else
+        if(type_->kind() != Kind::Array)
+        {
+            throw MemberAccessException("Type '" + type_->name() + "' has no elements.");
+        }
+
+        const Array& array = static_cast<const Array&>(*type_);
+        if(index >= array.size())
         {
-            throw DataAccessException("'" + method + "' can only be called from members with primitive types. "
-                   "It was called from type '" + type_.name() + "'.");
+            throw MemberAccessException("Type '" + type_->name() + "' has no element " + std::to_string(index) + ".");
         }
 
-        const CType<T>& ctype = static_cast<const CType<T>&>(type_);
-        if(typeid(T).hash_code() != ctype.hash_code())
+        return array;
+#endif
+    }
+
+    /// With RUNTYPES_UNCHECKED defined, the type is only asserted.
+    template <typename T>
+    bool validate_data_type(const char* method) const
+    {
+#ifdef RUNTYPES_UNCHECKED
+        (void)method;
+        assert(type_->is<T>() && "type differs");
+#else
+        if(!type_->is<T>())
         {
-            throw DataAccessException("Type '" + type_.name() + "' differs from '" + typeid(T).name() + "'.");
+            throw_data_type_error(method, typeid(T).name());
         }
+#endif
 
         return true;
     }
 
-    const Type& type_;
+    void throw_data_type_error(const char* method, const char* requested_type) const
+    {
+        if(type_->kind() != Kind::CType)
+        {
+            throw DataAccessException("'" + std::string(method) + "' can only be called from members with primitive types. "
+                   "It was called from type '" + type_->name() + "'.");
+        }
+
+        throw DataAccessException("Type '" + type_->name() + "' differs from '" + requested_type + "'.");
+    }
+
+    const Type* type_;
     uint8_t* memory_;
 };
 
@@ -94,16 +264,59 @@ class WritableDataRef : public ReadableDataRef
 {
 public:
     WritableDataRef(const WritableDataRef&) = default;
-    virtual ~WritableDataRef() = default;
+    WritableDataRef& operator=(const WritableDataRef&) = delete;
+    ~WritableDataRef() = default;
 
     uint8_t* memory() { return memory_; }
 
-    WritableDataRef operator[](const std::string& name)
+    using ReadableDataRef::operator[];
+
+    WritableDataRef operator[](StringView name)
+    {
+        const Member* member = get_member(name);
+        return WritableDataRef(member->type(), memory_ + member->offset());
+    }
+
+    WritableDataRef operator[](const Symbol& name)
     {
         const Member* member = get_member(name);
         return WritableDataRef(member->type(), memory_ + member->offset());
     }
 
+    WritableDataRef operator[](size_t index)
+    {
+        const Array& array = get_array(index);
+        return WritableDataRef(array.element(), memory_ + index * array.stride());
+    }
+
+    using ReadableDataRef::at;
+
+    WritableDataRef at(StringView path)
+    {
+        const MemberPath* member = get_member_path(path);
+        return WritableDataRef(*member->type, memory_ + member->offset);
+    }
+
+    using ReadableDataRef::find;
+
+    WritableDataRef find(StringView name)
+    {
+        const Member* member = find_member(name);
+        return member ? WritableDataRef(member->type(), memory_ + member->offset()) : WritableDataRef();
+    }
+
+    WritableDataRef find(const Symbol& name)
+    {
+        const Member* member = find_member(name);
+        return member ? WritableDataRef(member->type(), memory_ + member->offset()) : WritableDataRef();
+    }
+
+    template <typename T>
+    T* try_get_mut()
+    {
+        return type_ && type_->is<T>() ? reinterpret_cast<T*>(memory_) : nullptr;
+    }
+
     template <typename T>
     T& get_mut()
     {
@@ -111,44 +324,213 @@ public:
         return *reinterpret_cast<T*>(memory_);
     }
 
+    /// Assigns 't' to the data. If 'T' is not copy assignable, the value is rebuilt by copy.
     template <typename T>
     void set(const T& t)
     {
         validate_data_type<T>("set");
-        reinterpret_cast<T*>(memory_)->~T();
-        new (memory_) T(t);
+        assign_value(*reinterpret_cast<T*>(memory_), t);
+    }
+
+    /// Moves 't' into the data, its resources are transferred instead of copied.
+    template <typename T, typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+    void set(T&& t)
+    {
+        validate_data_type<T>("set");
+        assign_value(*reinterpret_cast<T*>(memory_), std::move(t));
+    }
+
+    /// As 'set', without validating the type. Only asserted in debug builds.
+    template <typename T>
+    void set_unchecked(const T& t)
+    {
+        assert(type_->is<T>() && "set_unchecked: type differs");
+        assign_value(*reinterpret_cast<T*>(memory_), t);
+    }
+
+    template <typename T, typename = typename std::enable_if<!std::is_reference<T>::value>::type>
+    void set_unchecked(T&& t)
+    {
+        assert(type_->is<T>() && "set_unchecked: type differs");
+        assign_value(*reinterpret_cast<T*>(memory_), std::move(t));
+    }
+
+    /// Replaces the value by a 'T' built in place from 'args'.
+    template <typename T, typename... Args>
+    void emplace(Args&&... args)
+    {
+        validate_data_type<T>("emplace");
+        if(std::is_nothrow_constructible<T, Args...>::value)
+        {
+            reinterpret_cast<T*>(memory_)->~T();
+            new (memory_) T(std::forward<Args>(args)...);
+        }
+        else
+        {
+            // Built before destroying the current value, so a throwing constructor leaves it untouched.
+            T t(std::forward<Args>(args)...);
+            reinterpret_cast<T*>(memory_)->~T();
+            new (memory_) T(std::move(t));
+        }
     }
 
 protected:
+    friend class DataArray;
+
     WritableDataRef(const Type& type, uint8_t* memory)
         : ReadableDataRef(type, memory)
     {}
+
+    WritableDataRef() = default;
+};
+
+
+//=========================== DataView =============================
+/// Non-owning access to an instance already built in 'memory',
+/// as an instance placed in a shared-memory segment by other process.
+class DataView : public WritableDataRef
+{
+public:
+    DataView(const Type& type, uint8_t* memory)
+        : WritableDataRef(type, memory)
+    {}
 };
 
 
 //=========================== Data =============================
+/// Owner of an instance. It can be used as a ref, but it must not be destroyed through a ref pointer.
+///
+/// The instances taken from the HeapAllocator that fit in INLINE_SIZE bytes are kept inside the Data,
+/// without an allocation, if their type moves without throwing. Those are moved member by member,
+/// so a ref taken from a Data is not valid after the Data is moved or swapped.
 class Data : public WritableDataRef
 {
 public:
-    Data(const Type& type)
-        : WritableDataRef(type, new uint8_t[type.memory_size()])
+    static constexpr size_t INLINE_SIZE = 64;
+
+    Data(const Type& type, Allocator& allocator = HeapAllocator::instance())
+        : WritableDataRef(type, nullptr)
+        , allocator_(&allocator)
     {
-        type_.build_object_at(memory_);
+        memory_ = acquire();
+        type_->build_object_at(memory_);
     }
 
     Data(const Data& other)
-        : WritableDataRef(other.type_, new uint8_t[other.type_.memory_size()])
+        : WritableDataRef(*other.type_, nullptr)
+        , allocator_(other.allocator_)
     {
-        type_.copy_object(memory_, other.memory_);
+        memory_ = acquire();
+        type_->copy_object(memory_, other.memory_);
     }
 
-    virtual ~Data()
+    /// Takes the instance of 'other', that can not be accessed anymore.
+    Data(Data&& other) noexcept
+        : WritableDataRef(*other.type_, nullptr)
+        , allocator_(other.allocator_)
     {
-        type_.destroy_object_at(memory_);
-        delete[] memory_;
+        take(other);
     }
+
+    Data& operator=(const Data& other)
+    {
+        Data copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    Data& operator=(Data&& other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            type_ = other.type_;
+            allocator_ = other.allocator_;
+            take(other);
+        }
+        return *this;
+    }
+
+    ~Data()
+    {
+        release();
+    }
+
+    void swap(Data& other) noexcept
+    {
+        if(!is_inline() && !other.is_inline())
+        {
+            std::swap(type_, other.type_);
+            std::swap(memory_, other.memory_);
+            std::swap(allocator_, other.allocator_);
+            return;
+        }
+
+        Data moved(std::move(other));
+        other = std::move(*this);
+        *this = std::move(moved);
+    }
+
+    Allocator& allocator() const { return *allocator_; }
+
+    /// True if the instance is kept inside the Data.
+    bool is_inline() const { return memory_ == inline_; }
+
+private:
+    uint8_t* acquire()
+    {
+        if(type_->memory_size() <= INLINE_SIZE
+            && type_->alignment() <= alignof(std::max_align_t)
+            && type_->is_nothrow_movable()
+            && allocator_ == &HeapAllocator::instance())
+        {
+            return inline_;
+        }
+        return allocator_->allocate(type_->memory_size(), type_->alignment());
+    }
+
+    void release()
+    {
+        if(memory_)
+        {
+            type_->destroy_object_at(memory_);
+            if(!is_inline())
+            {
+                allocator_->deallocate(memory_, type_->memory_size(), type_->alignment());
+            }
+            memory_ = nullptr;
+        }
+    }
+
+    // Expects this instance released and the type and allocator of 'other' already taken.
+    void take(Data& other) noexcept
+    {
+        if(other.is_inline())
+        {
+            memory_ = inline_;
+            type_->move_object(memory_, other.memory_);
+            type_->destroy_object_at(other.memory_);
+        }
+        else
+        {
+            memory_ = other.memory_;
+        }
+        other.memory_ = nullptr;
+    }
+
+    Allocator* allocator_;
+    alignas(std::max_align_t) uint8_t inline_[INLINE_SIZE];
 };
 
+inline void swap(Data& a, Data& b) noexcept
+{
+    a.swap(b);
+}
+
+static_assert(std::is_trivially_copyable<ReadableDataRef>::value, "ReadableDataRef must be trivially copyable");
+static_assert(std::is_trivially_copyable<WritableDataRef>::value, "WritableDataRef must be trivially copyable");
+static_assert(sizeof(WritableDataRef) == 2 * sizeof(void*), "A data ref must hold only two pointers");
+
 
 } //namespace rt
 
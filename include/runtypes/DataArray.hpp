@@ -0,0 +1,280 @@
+#ifndef RT__DATA_ARRAY_HPP_
+#define RT__DATA_ARRAY_HPP_
+
+#include <runtypes/Data.hpp>
+#include <runtypes/Exception.hpp>
+
+namespace rt
+{
+
+//=========================== DataArray =============================
+/// Dynamic number of instances of a type, placed back to back in a single memory block.
+/// The instances are accessed by index, as a vector.
+class DataArray
+{
+public:
+    DataArray(const Type& type, Allocator& allocator = HeapAllocator::instance())
+        : type_(type)
+        , allocator_(allocator)
+        , stride_(align_up(type.memory_size(), type.alignment()))
+        , memory_(nullptr)
+        , size_(0)
+        , capacity_(0)
+    {}
+
+    DataArray(const DataArray& other)
+        : DataArray(other.type_, other.allocator_)
+    {
+        reserve(other.size_);
+        while(size_ < other.size_)
+        {
+            type_.copy_object(element(size_), other.element(size_));
+            size_++;
+        }
+    }
+
+    /// Takes the instances of 'other', that becomes empty.
+    DataArray(DataArray&& other) noexcept
+        : type_(other.type_)
+        , allocator_(other.allocator_)
+        , stride_(other.stride_)
+        , memory_(other.memory_)
+        , size_(other.size_)
+        , capacity_(other.capacity_)
+    {
+        other.memory_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    ~DataArray()
+    {
+        clear();
+        release(memory_, capacity_);
+    }
+
+    const Type& type() const { return type_; }
+    Allocator& allocator() const { return allocator_; }
+    size_t stride() const { return stride_; }
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    uint8_t* memory() { return memory_; }
+    const uint8_t* memory() const { return memory_; }
+
+    ReadableDataRef operator[](size_t index) const
+    {
+        return ReadableDataRef(type_, element(index));
+    }
+
+    WritableDataRef operator[](size_t index)
+    {
+        return WritableDataRef(type_, element(index));
+    }
+
+    ReadableDataRef at(size_t index) const
+    {
+        validate_index(index);
+        return (*this)[index];
+    }
+
+    WritableDataRef at(size_t index)
+    {
+        validate_index(index);
+        return (*this)[index];
+    }
+
+    ReadableDataRef back() const { return (*this)[size_ - 1]; }
+    WritableDataRef back() { return (*this)[size_ - 1]; }
+
+    void reserve(size_t capacity)
+    {
+        if(capacity <= capacity_)
+        {
+            return;
+        }
+
+        uint8_t* memory = stride_ * capacity > 0 ? allocator_.allocate(stride_ * capacity, type_.alignment()) : nullptr;
+        try
+        {
+            relocate(memory);
+        }
+        catch(...)
+        {
+            release(memory, capacity);
+            throw;
+        }
+        release(memory_, capacity_);
+        memory_ = memory;
+        capacity_ = capacity;
+    }
+
+    /// Appends a default instance of the type.
+    WritableDataRef push_back()
+    {
+        grow();
+        type_.build_object_at(element(size_));
+        return (*this)[size_++];
+    }
+
+    /// Appends a copy of 'value', that must be an instance of the same type.
+    WritableDataRef push_back(const ReadableDataRef& value)
+    {
+        if(!type_.equivalent(value.type()))
+        {
+            throw DataAccessException("Type " + value.type().display_name() + " differs from " + type_.display_name() + ".");
+        }
+
+        uint8_t* source = const_cast<uint8_t*>(value.memory());
+        if(size_ < capacity_)
+        {
+            type_.copy_object(element(size_), source);
+            return (*this)[size_++];
+        }
+
+        // 'value' can be an instance of this array: it is copied before the current block is released.
+        const size_t capacity = next_capacity();
+        uint8_t* memory = allocator_.allocate(stride_ * capacity, type_.alignment());
+        try
+        {
+            type_.copy_object(memory + size_ * stride_, source);
+        }
+        catch(...)
+        {
+            release(memory, capacity);
+            throw;
+        }
+
+        try
+        {
+            relocate(memory);
+        }
+        catch(...)
+        {
+            type_.destroy_object_at(memory + size_ * stride_);
+            release(memory, capacity);
+            throw;
+        }
+        release(memory_, capacity_);
+        memory_ = memory;
+        capacity_ = capacity;
+        return (*this)[size_++];
+    }
+
+    void pop_back()
+    {
+        type_.destroy_object_at(element(--size_));
+    }
+
+    void resize(size_t size)
+    {
+        reserve(size);
+        while(size_ < size)
+        {
+            type_.build_object_at(element(size_++));
+        }
+        while(size_ > size)
+        {
+            pop_back();
+        }
+    }
+
+    void clear()
+    {
+        resize(0);
+    }
+
+private:
+    uint8_t* element(size_t index) const
+    {
+        return memory_ + index * stride_;
+    }
+
+    void validate_index(size_t index) const
+    {
+        if(index >= size_)
+        {
+            throw DataAccessException("Index " + std::to_string(index) + " out of range, "
+                   "the array has " + std::to_string(size_) + " instances.");
+        }
+    }
+
+    size_t next_capacity() const
+    {
+        return capacity_ > 0 ? capacity_ * 2 : 4;
+    }
+
+    void grow()
+    {
+        if(size_ == capacity_)
+        {
+            reserve(next_capacity());
+        }
+    }
+
+    // Moves the current instances to 'memory'. The types that can throw while moving are copied instead,
+    // as std::move_if_noexcept does: if a copy throws, the current instances are kept untouched.
+    void relocate(uint8_t* memory)
+    {
+        if(type_.is_trivially_copyable())
+        {
+            if(size_ > 0)
+            {
+                std::memcpy(memory, memory_, size_ * stride_);
+            }
+            return;
+        }
+
+        if(type_.is_nothrow_movable())
+        {
+            for(size_t i = 0; i < size_; i++)
+            {
+                type_.move_object(memory + i * stride_, element(i));
+                type_.destroy_object_at(element(i));
+            }
+            return;
+        }
+
+        size_t copied = 0;
+        try
+        {
+            for(; copied < size_; copied++)
+            {
+                type_.copy_object(memory + copied * stride_, element(copied));
+            }
+        }
+        catch(...)
+        {
+            while(copied > 0)
+            {
+                type_.destroy_object_at(memory + --copied * stride_);
+            }
+            throw;
+        }
+
+        for(size_t i = 0; i < size_; i++)
+        {
+            type_.destroy_object_at(element(i));
+        }
+    }
+
+    void release(uint8_t* memory, size_t capacity)
+    {
+        if(memory)
+        {
+            allocator_.deallocate(memory, stride_ * capacity, type_.alignment());
+        }
+    }
+
+    const Type& type_;
+    Allocator& allocator_;
+    size_t stride_;
+    uint8_t* memory_;
+    size_t size_;
+    size_t capacity_;
+};
+
+} //namespace rt
+
+#endif //RT__DATA_ARRAY_HPP_
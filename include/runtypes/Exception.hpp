@@ -27,6 +27,8 @@ RT_DEFINE_STRING_BASED_EXCEPTION(Runtype, std::runtime_error)
 RT_DEFINE_RUNTYPE_EXCEPTION(DataAccess)
 RT_DEFINE_RUNTYPE_EXCEPTION(MemberAccess)
 RT_DEFINE_RUNTYPE_EXCEPTION(MemberAdd)
+RT_DEFINE_RUNTYPE_EXCEPTION(Allocation)
+RT_DEFINE_RUNTYPE_EXCEPTION(Serialization)
 
 } //namespace rt
 
@@ -0,0 +1,280 @@
+#ifndef RT__NAME_INDEX_HPP_
+#define RT__NAME_INDEX_HPP_
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace rt
+{
+
+//=========================== Hash =============================
+/// Hash of a name, mixing 8 bytes per step.
+inline uint64_t hash_name(const char* name, size_t size)
+{
+    const uint64_t multiplier = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = size * multiplier;
+    size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, name + i, 8);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+
+    uint64_t tail = 0;
+    for(size_t shift = 0; i < size; i++, shift += 8)
+    {
+        tail |= static_cast<uint64_t>(static_cast<uint8_t>(name[i])) << shift;
+    }
+    hash = (hash ^ tail) * multiplier;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+//=========================== NameIndex =============================
+/// Open addressing hash table that maps a name hash to a position in an external container.
+/// The names are not stored: the caller checks the candidates with its own comparison.
+class NameIndex
+{
+public:
+    static constexpr uint32_t npos = ~0u;
+
+    NameIndex()
+        : size_(0)
+    {}
+
+    size_t size() const { return size_; }
+
+    void clear()
+    {
+        slots_.clear();
+        size_ = 0;
+    }
+
+    void insert(uint64_t hash, uint32_t position)
+    {
+        if((size_ + 1) * 4 > slots_.size() * 3) // Max load factor: 0.75
+        {
+            rehash(slots_.empty() ? 8 : slots_.size() * 2);
+        }
+        place(Slot{static_cast<uint32_t>(hash), position + 1});
+        size_++;
+    }
+
+    /// Returns the position whose hash is 'hash' and satisfies 'equal(position)', or npos.
+    template <typename Equal>
+    uint32_t find(uint64_t hash, Equal&& equal) const
+    {
+        if(slots_.empty())
+        {
+            return npos;
+        }
+
+        const size_t mask = slots_.size() - 1;
+        const uint32_t fragment = static_cast<uint32_t>(hash);
+        for(size_t i = fragment & mask; slots_[i].position != 0; i = (i + 1) & mask)
+        {
+            if(slots_[i].hash == fragment && equal(slots_[i].position - 1))
+            {
+                return slots_[i].position - 1;
+            }
+        }
+        return npos;
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t hash; //Lower bits of the name hash
+        uint32_t position; //Position + 1, 0 means empty slot
+    };
+
+    void rehash(size_t slot_count)
+    {
+        std::vector<Slot> old_slots(slot_count, Slot{0, 0});
+        old_slots.swap(slots_);
+        for(auto&& slot: old_slots)
+        {
+            if(slot.position != 0)
+            {
+                place(slot);
+            }
+        }
+    }
+
+    void place(Slot slot)
+    {
+        const size_t mask = slots_.size() - 1;
+        size_t i = slot.hash & mask;
+        while(slots_[i].position != 0)
+        {
+            i = (i + 1) & mask;
+        }
+        slots_[i] = slot;
+    }
+
+    std::vector<Slot> slots_;
+    size_t size_;
+};
+
+//=========================== PerfectIndex =============================
+/// Minimal perfect hash over a fixed set of name hashes, built by hash and displace:
+/// the hashes are split in buckets and, from the largest bucket, each bucket searches a displacement
+/// that sends all its hashes to free slots. There are as many slots as hashes.
+/// A lookup reads one displacement and one slot, so the caller checks a single candidate.
+class PerfectIndex
+{
+public:
+    static constexpr uint32_t npos = NameIndex::npos;
+
+    bool empty() const { return slots_.empty(); }
+
+    void clear()
+    {
+        displacements_.clear();
+        slots_.clear();
+    }
+
+    /// Builds the index, the position of each hash is its place in 'hashes'.
+    /// Returns false, leaving the index empty, if no perfect hash is found, as with repeated hashes.
+    bool build(const std::vector<uint64_t>& hashes)
+    {
+        clear();
+
+        const uint32_t size = static_cast<uint32_t>(hashes.size());
+        std::vector<uint64_t> sorted(hashes);
+        std::sort(sorted.begin(), sorted.end());
+        if(size == 0 || std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end())
+        {
+            return false;
+        }
+
+        const uint32_t bucket_count = size / 2 + 1;
+        std::vector<std::vector<uint32_t>> buckets(bucket_count);
+        for(uint32_t i = 0; i < size; i++)
+        {
+            buckets[bucket_of(hashes[i], bucket_count)].push_back(i);
+        }
+
+        std::vector<uint32_t> order(bucket_count);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+        {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        // The last buckets find a free slot with probability 1/size by displacement,
+        // the limit is far away from the expected number of attempts.
+        const uint64_t max_displacement = uint64_t(size) * 64 + 1024;
+
+        std::vector<uint32_t> displacements(bucket_count, 0);
+        std::vector<Slot> slots(size, Slot{0, 0});
+        std::vector<uint32_t> candidates;
+        for(auto&& bucket: order)
+        {
+            const std::vector<uint32_t>& positions = buckets[bucket];
+            if(positions.empty())
+            {
+                break;
+            }
+
+            uint32_t displacement = 0;
+            while(!try_place(hashes, positions, displacement, slots, candidates))
+            {
+                if(++displacement == max_displacement)
+                {
+                    return false;
+                }
+            }
+            displacements[bucket] = displacement;
+        }
+
+        displacements_.swap(displacements);
+        slots_.swap(slots);
+        return true;
+    }
+
+    /// Returns the position of 'hash' if it satisfies 'equal(position)', or npos.
+    template <typename Equal>
+    uint32_t find(uint64_t hash, Equal&& equal) const
+    {
+        if(slots_.empty())
+        {
+            return npos;
+        }
+
+        const uint32_t displacement = displacements_[bucket_of(hash, static_cast<uint32_t>(displacements_.size()))];
+        const Slot& slot = slots_[slot_of(hash, displacement, static_cast<uint32_t>(slots_.size()))];
+        if(slot.hash == static_cast<uint32_t>(hash) && equal(slot.position - 1))
+        {
+            return slot.position - 1;
+        }
+        return npos;
+    }
+
+private:
+    struct Slot
+    {
+        uint32_t hash; //Lower bits of the name hash
+        uint32_t position; //Position + 1, 0 means empty slot
+    };
+
+    // Maps a 32 bits value to [0, size) without division.
+    static uint32_t reduce(uint32_t value, uint32_t size)
+    {
+        return static_cast<uint32_t>((uint64_t(value) * size) >> 32);
+    }
+
+    // Splitmix64 finalizer, gives independent slots for each displacement.
+    static uint64_t remix(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+        return value ^ (value >> 31);
+    }
+
+    static uint32_t bucket_of(uint64_t hash, uint32_t bucket_count)
+    {
+        return reduce(static_cast<uint32_t>(hash >> 32), bucket_count);
+    }
+
+    static uint32_t slot_of(uint64_t hash, uint32_t displacement, uint32_t size)
+    {
+        return reduce(static_cast<uint32_t>(remix(hash + displacement) >> 32), size);
+    }
+
+    static bool try_place(const std::vector<uint64_t>& hashes, const std::vector<uint32_t>& positions,
+        uint32_t displacement, std::vector<Slot>& slots, std::vector<uint32_t>& candidates)
+    {
+        const uint32_t size = static_cast<uint32_t>(slots.size());
+        candidates.clear();
+        for(auto&& position: positions)
+        {
+            const uint32_t slot = slot_of(hashes[position], displacement, size);
+            if(slots[slot].position != 0 || std::find(candidates.begin(), candidates.end(), slot) != candidates.end())
+            {
+                return false;
+            }
+            candidates.push_back(slot);
+        }
+
+        for(size_t i = 0; i < positions.size(); i++)
+        {
+            slots[candidates[i]] = Slot{static_cast<uint32_t>(hashes[positions[i]]), positions[i] + 1};
+        }
+        return true;
+    }
+
+    std::vector<uint32_t> displacements_; //By bucket
+    std::vector<Slot> slots_;
+};
+
+} //namespace rt
+
+#endif //RT__NAME_INDEX_HPP_
@@ -0,0 +1,166 @@
+#ifndef RT__POOL_ALLOCATOR_HPP_
+#define RT__POOL_ALLOCATOR_HPP_
+
+#include <runtypes/Allocator.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace rt
+{
+
+//=========================== PoolAllocator =============================
+/// Allocator that keeps the released blocks in free lists by size class, one set of lists per thread,
+/// so the instances of the same few types are created and destroyed without reaching the heap
+/// and without locks. A block released by other thread is kept by the thread that releases it.
+///
+/// Blocks bigger than MAX_BLOCK_SIZE or with an alignment stricter than std::max_align_t
+/// are taken from the HeapAllocator.
+class PoolAllocator : public Allocator
+{
+public:
+    static constexpr size_t CLASS_SIZE = alignof(std::max_align_t); //Size classes are multiples of it
+    static constexpr size_t MAX_BLOCK_SIZE = 1024;
+    static constexpr size_t MAX_CACHED_BLOCKS = 1024; //By size class and thread
+    static constexpr size_t CLASS_COUNT = MAX_BLOCK_SIZE / CLASS_SIZE;
+
+    struct Stats
+    {
+        size_t hits;   //Allocations served from a free list
+        size_t misses; //Allocations served from the heap
+    };
+
+    static PoolAllocator& instance()
+    {
+        static PoolAllocator allocator;
+        return allocator;
+    }
+
+    virtual uint8_t* allocate(size_t size, size_t alignment) override
+    {
+        ThreadCache& cache = thread_cache();
+        if(!pooled(size, alignment))
+        {
+            cache.stats.misses++;
+            return HeapAllocator::instance().allocate(size, alignment);
+        }
+
+        FreeList& list = cache.lists[size_class(size)];
+        if(list.head)
+        {
+            cache.stats.hits++;
+            Block* block = list.head;
+            list.head = block->next;
+            list.count--;
+            return reinterpret_cast<uint8_t*>(block);
+        }
+
+        cache.stats.misses++;
+        return static_cast<uint8_t*>(::operator new(class_block_size(size_class(size))));
+    }
+
+    virtual void deallocate(uint8_t* memory, size_t size, size_t alignment) override
+    {
+        if(!pooled(size, alignment))
+        {
+            HeapAllocator::instance().deallocate(memory, size, alignment);
+            return;
+        }
+
+        FreeList& list = thread_cache().lists[size_class(size)];
+        if(list.count == MAX_CACHED_BLOCKS)
+        {
+            ::operator delete(memory);
+            return;
+        }
+
+        Block* block = reinterpret_cast<Block*>(memory);
+        block->next = list.head;
+        list.head = block;
+        list.count++;
+    }
+
+    /// Statistics of the calling thread.
+    Stats stats() const { return thread_cache().stats; }
+
+    void reset_stats() { thread_cache().stats = Stats{0, 0}; }
+
+    /// Releases to the heap the blocks kept by the calling thread.
+    void trim() { thread_cache().release(); }
+
+    /// Blocks kept by the calling thread for allocations of 'size' bytes.
+    size_t cached_blocks(size_t size) const
+    {
+        return size <= MAX_BLOCK_SIZE ? thread_cache().lists[size_class(size)].count : 0;
+    }
+
+private:
+    struct Block
+    {
+        Block* next;
+    };
+
+    struct FreeList
+    {
+        Block* head;
+        size_t count;
+    };
+
+    struct ThreadCache
+    {
+        ThreadCache()
+            : lists()
+            , stats{0, 0}
+        {}
+
+        ~ThreadCache()
+        {
+            release();
+        }
+
+        void release()
+        {
+            for(auto&& list: lists)
+            {
+                while(list.head)
+                {
+                    Block* block = list.head;
+                    list.head = block->next;
+                    ::operator delete(block);
+                }
+                list.count = 0;
+            }
+        }
+
+        FreeList lists[CLASS_COUNT];
+        Stats stats;
+    };
+
+    PoolAllocator() = default;
+
+    static ThreadCache& thread_cache()
+    {
+        static thread_local ThreadCache cache;
+        return cache;
+    }
+
+    static bool pooled(size_t size, size_t alignment)
+    {
+        return size <= MAX_BLOCK_SIZE && alignment <= alignof(std::max_align_t);
+    }
+
+    // Empty objects take the smallest class: a block must hold the free list link.
+    static size_t size_class(size_t size)
+    {
+        return size == 0 ? 0 : (size - 1) / CLASS_SIZE;
+    }
+
+    static size_t class_block_size(size_t size_class)
+    {
+        return (size_class + 1) * CLASS_SIZE;
+    }
+};
+
+} //namespace rt
+
+#endif //RT__POOL_ALLOCATOR_HPP_
@@ -0,0 +1,63 @@
+#ifndef RT__SEGMENT_HPP_
+#define RT__SEGMENT_HPP_
+
+#include <runtypes/Allocator.hpp>
+#include <runtypes/Exception.hpp>
+
+namespace rt
+{
+
+//=========================== Segment =============================
+/// Allocator that packs instances one after another into a memory region supplied by the caller,
+/// as a POSIX shared-memory segment or a mmaped file.
+/// The memory is never released one by one, only all together by reset().
+///
+/// Other processes mapping the same region access the instances through their offsets in the segment.
+/// Mapped regions are page aligned, so the instance alignments are kept among processes.
+/// Only members with no pointers to process memory (as std::string or std::vector)
+/// can be shared among processes.
+class Segment : public Allocator
+{
+public:
+    Segment(void* memory, size_t size)
+        : memory_(static_cast<uint8_t*>(memory))
+        , size_(size)
+        , used_(0)
+    {}
+
+    virtual uint8_t* allocate(size_t size, size_t alignment) override
+    {
+        uintptr_t base = reinterpret_cast<uintptr_t>(memory_);
+        size_t offset = align_up(base + used_, alignment) - base;
+        if(offset + size > size_)
+        {
+            throw AllocationException("Segment has no space for " + std::to_string(size) + " bytes, "
+                   "only " + std::to_string(available()) + " bytes are available.");
+        }
+
+        used_ = offset + size;
+        return memory_ + offset;
+    }
+
+    virtual void deallocate(uint8_t*, size_t, size_t) override
+    {} // Released all together by reset()
+
+    void reset() { used_ = 0; }
+
+    uint8_t* memory() const { return memory_; }
+    size_t size() const { return size_; }
+    size_t used() const { return used_; }
+    size_t available() const { return size_ - used_; }
+
+    size_t offset(const uint8_t* address) const { return address - memory_; }
+    uint8_t* address(size_t offset) const { return memory_ + offset; }
+
+private:
+    uint8_t* memory_;
+    size_t size_;
+    size_t used_;
+};
+
+} //namespace rt
+
+#endif //RT__SEGMENT_HPP_
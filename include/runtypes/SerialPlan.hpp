@@ -0,0 +1,207 @@
+#ifndef RT__SERIAL_PLAN_HPP_
+#define RT__SERIAL_PLAN_HPP_
+
+#include <runtypes/Exception.hpp>
+
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+namespace rt
+{
+
+//=========================== Buffer =============================
+/// Bytes of serialized data. Written at the end and read from the read position.
+/// Values are written with the native byte order.
+class Buffer
+{
+public:
+    Buffer()
+        : position_(0)
+    {}
+
+    void write(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        bytes_.insert(bytes_.end(), bytes, bytes + size);
+    }
+
+    void read(void* data, size_t size)
+    {
+        if(size > bytes_.size() - position_)
+        {
+            throw SerializationException("Buffer has no " + std::to_string(size) + " bytes to read, "
+                   "only " + std::to_string(bytes_.size() - position_) + " bytes are available.");
+        }
+
+        if(size > 0)
+        {
+            std::memcpy(data, bytes_.data() + position_, size);
+        }
+        position_ += size;
+    }
+
+    void write_size(uint64_t size) { write(&size, sizeof(size)); }
+    uint64_t read_size() { uint64_t size; read(&size, sizeof(size)); return size; }
+
+    /// Reads the number of elements of a sequence whose elements take at least 'element_size' bytes each,
+    /// so a corrupt count is rejected before anything is allocated for it.
+    uint64_t read_count(size_t element_size)
+    {
+        const uint64_t count = read_size();
+        const size_t available = bytes_.size() - position_;
+        if(count > available / element_size)
+        {
+            throw SerializationException("Buffer can not hold " + std::to_string(count) + " elements of "
+                   + std::to_string(element_size) + " bytes, only " + std::to_string(available) + " bytes are available.");
+        }
+        return count;
+    }
+
+    /// Replaces the content by 'size' bytes from 'data', as bytes received from other process.
+    void assign(const void* data, size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        bytes_.assign(bytes, bytes + size);
+        position_ = 0;
+    }
+
+    void reserve(size_t capacity) { bytes_.reserve(capacity); }
+    void rewind() { position_ = 0; }
+    void clear() { bytes_.clear(); position_ = 0; }
+
+    const uint8_t* data() const { return bytes_.data(); }
+    size_t size() const { return bytes_.size(); }
+    size_t position() const { return position_; }
+
+private:
+    std::vector<uint8_t> bytes_;
+    size_t position_;
+};
+
+//=========================== CodecFunctions =============================
+/// Serialization functions of a non trivially copyable type. See Codec.hpp.
+struct CodecFunctions
+{
+    void (*encode)(const uint8_t* location, Buffer& buffer);
+    void (*decode)(uint8_t* location, Buffer& buffer);
+};
+
+//=========================== SerialPlan =============================
+/// Flat list of serialization operations of a type, with offsets relative to the object.
+/// Contiguous trivially copyable members are merged into a single bytes operation.
+class SerialPlan
+{
+public:
+    enum class Code
+    {
+        Bytes,       //Copies 'size' bytes.
+        Codec,       //Calls the codec functions.
+        Unsupported, //No codec exists for the type.
+    };
+
+    struct Op
+    {
+        Code code;
+        size_t offset;
+        size_t size;
+        const CodecFunctions* codec;
+        const char* type_name; //Used by the unsupported operation to report the error.
+    };
+
+    static SerialPlan bytes(size_t size)
+    {
+        SerialPlan plan;
+        if(size > 0)
+        {
+            plan.ops_.push_back(Op{Code::Bytes, 0, size, nullptr, nullptr});
+        }
+        return plan;
+    }
+
+    static SerialPlan codec(size_t size, const CodecFunctions& codec)
+    {
+        SerialPlan plan;
+        plan.ops_.push_back(Op{Code::Codec, 0, size, &codec, nullptr});
+        return plan;
+    }
+
+    static SerialPlan unsupported(size_t size, const char* type_name)
+    {
+        SerialPlan plan;
+        plan.ops_.push_back(Op{Code::Unsupported, 0, size, nullptr, type_name});
+        return plan;
+    }
+
+    const std::vector<Op>& ops() const { return ops_; }
+
+    void clear() { ops_.clear(); }
+
+    /// Appends the operations of 'plan' placed at 'offset'.
+    /// The operations must be appended in offset order.
+    void append(const SerialPlan& plan, size_t offset)
+    {
+        for(auto&& op: plan.ops_)
+        {
+            if(op.code == Code::Bytes && !ops_.empty() && ops_.back().code == Code::Bytes)
+            {
+                // Both operations are only separated by padding, if any.
+                ops_.back().size = offset + op.offset + op.size - ops_.back().offset;
+            }
+            else
+            {
+                ops_.push_back(op);
+                ops_.back().offset += offset;
+            }
+        }
+    }
+
+    void encode(const uint8_t* location, Buffer& buffer) const
+    {
+        for(auto&& op: ops_)
+        {
+            switch(op.code)
+            {
+                case Code::Bytes:
+                    buffer.write(location + op.offset, op.size);
+                    break;
+                case Code::Codec:
+                    op.codec->encode(location + op.offset, buffer);
+                    break;
+                case Code::Unsupported:
+                    throw_unsupported(op);
+            }
+        }
+    }
+
+    void decode(uint8_t* location, Buffer& buffer) const
+    {
+        for(auto&& op: ops_)
+        {
+            switch(op.code)
+            {
+                case Code::Bytes:
+                    buffer.read(location + op.offset, op.size);
+                    break;
+                case Code::Codec:
+                    op.codec->decode(location + op.offset, buffer);
+                    break;
+                case Code::Unsupported:
+                    throw_unsupported(op);
+            }
+        }
+    }
+
+private:
+    static void throw_unsupported(const Op& op)
+    {
+        throw SerializationException("Type '" + std::string(op.type_name) + "' has no codec. "
+               "Specialize rt::Codec for it to be serialized.");
+    }
+
+    std::vector<Op> ops_;
+};
+
+} //namespace rt
+
+#endif //RT__SERIAL_PLAN_HPP_
@@ -0,0 +1,33 @@
+#ifndef RT__SERIALIZATION_HPP_
+#define RT__SERIALIZATION_HPP_
+
+#include <runtypes/Data.hpp>
+#include <runtypes/Codec.hpp>
+
+namespace rt
+{
+
+/// Writes the binary representation of 'data' at the end of 'buffer'.
+/// The serialization follows the type serial plan, computed once by the type definition:
+/// contiguous trivially copyable members are written with a single copy,
+/// 'std::string' and 'std::vector' members are prefixed by their length and nested structs are inlined.
+/// Other non trivially copyable types need a rt::Codec specialization.
+inline void serialize(const ReadableDataRef& data, Buffer& buffer)
+{
+    data.type().serial_plan().encode(data.memory(), buffer);
+}
+
+/// Reads from the read position of 'buffer' the binary representation of an instance of the 'data' type.
+inline void deserialize(WritableDataRef& data, Buffer& buffer)
+{
+    data.type().serial_plan().decode(data.memory(), buffer);
+}
+
+inline void deserialize(WritableDataRef&& data, Buffer& buffer)
+{
+    deserialize(data, buffer);
+}
+
+} //namespace rt
+
+#endif //RT__SERIALIZATION_HPP_
@@ -0,0 +1,65 @@
+#ifndef RT__STRING_VIEW_HPP_
+#define RT__STRING_VIEW_HPP_
+
+#include <cstring>
+#include <string>
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace rt
+{
+
+//=========================== StringView =============================
+/// Non-owning reference to a sequence of characters, as std::string_view for C++11.
+/// Used by the lookups, so a key given as a literal or as a std::string is never copied.
+class StringView
+{
+public:
+    StringView(const char* data)
+        : data_(data)
+        , size_(std::strlen(data))
+    {}
+
+    StringView(const char* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {}
+
+    StringView(const std::string& string)
+        : data_(string.data())
+        , size_(string.size())
+    {}
+
+#if __cplusplus >= 201703L
+    StringView(std::string_view string)
+        : data_(string.data())
+        , size_(string.size())
+    {}
+#endif
+
+    const char* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    std::string to_string() const { return std::string(data_, size_); }
+
+    friend bool operator==(StringView a, StringView b)
+    {
+        return a.size_ == b.size_ && (a.size_ == 0 || std::memcmp(a.data_, b.data_, a.size_) == 0);
+    }
+
+    friend bool operator!=(StringView a, StringView b)
+    {
+        return !(a == b);
+    }
+
+private:
+    const char* data_;
+    size_t size_;
+};
+
+} //namespace rt
+
+#endif //RT__STRING_VIEW_HPP_
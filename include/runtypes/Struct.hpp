@@ -3,64 +3,81 @@
 
 #include <runtypes/Exception.hpp>
 #include <runtypes/CType.hpp>
+#include <runtypes/Array.hpp>
+#include <runtypes/NameIndex.hpp>
+#include <runtypes/Symbol.hpp>
+#include <runtypes/Allocator.hpp>
 
-#include <map>
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 namespace rt
 {
 
+template <typename T>
+class Accessor;
+
 //=========================== MEMBER =============================
+/// The member types are shared: copying a member does not copy its type.
 class Member
 {
 public:
-    static Member ref(size_t offset, const Type& type)
+    /// Member of an immutable snapshot of 'type', or of 'type' itself if it is already shared.
+    static Member share(const std::string& name, size_t offset, const Type& type)
     {
-        return Member(offset, type, false);
+        return Member(name, offset, TypeRef::share(type));
     }
 
     template<typename T, typename... Args>
-    static Member create_ctype(size_t offset, Args&&... args)
-    {
-        return Member(offset, *new CType<T>(std::forward<Args>(args)...), true);
-    }
-
-    Member(const Member& other)
-        : offset_(other.offset())
-        , type_(other.managed_ ? *other.type_.clone().release() : other.type_)
-        , managed_(other.managed_)
-    {}
-
-    Member(Member&& other)
-        : offset_(std::move(other.offset_))
-        , type_(std::move(other.type_))
-        , managed_(std::move(other.managed_))
+    static Member create_ctype(const std::string& name, size_t offset, Args&&... args)
     {
-        other.managed_ = false;
+        return Member(name, offset, TypeRef(std::unique_ptr<Type>(new CType<T>(std::forward<Args>(args)...))));
     }
 
-    virtual ~Member()
-    {
-        if(managed_)
-        {
-            delete &type_;
-        }
-    }
-
-    const Type& type() const { return type_; }
+    const std::string& name() const { return name_.name(); }
+    const Symbol& symbol() const { return name_; }
+    const Type& type() const { return *type_; }
+    const TypeRef& type_ref() const { return type_; }
     size_t offset() const { return offset_; }
-    bool managed() const { return managed_; }
 
 private:
-    Member(size_t offset, const Type& type, bool managed)
-        : offset_(offset)
-        , type_(type)
-        , managed_(managed)
+    Member(const std::string& name, size_t offset, TypeRef type)
+        : name_(name)
+        , offset_(offset)
+        , type_(std::move(type))
     { }
 
+    friend class Struct;
+
+    Symbol name_;
     size_t offset_;
-    const Type& type_;
-    bool managed_;
+    TypeRef type_;
+};
+
+//=========================== MEMBER PATH =============================
+/// Member reached through a dotted path ("inner.values"),
+/// placed at 'offset' from the beginning of the struct that resolves the path.
+struct MemberPath
+{
+    std::string path;
+    size_t offset;
+    const Type* type;
+};
+
+//=========================== LAYOUT =============================
+enum class LayoutPolicy
+{
+    Declared, //Members placed in declaration order, as the compiler does.
+    Compact,  //Members placed by descending alignment and size, minimizing padding.
+};
+
+struct LayoutReport
+{
+    size_t memory_size;          //Current memory size.
+    size_t declared_memory_size; //Memory size using the declaration order.
+    size_t padding;              //Bytes not used by any member.
+    size_t saved_bytes;          //Bytes saved in relation to the declaration order.
 };
 
 //=========================== STRUCT =============================
@@ -68,33 +85,45 @@ class Struct : public Type
 {
 public:
     Struct(const std::string& name = "")
-        : Type(Kind::Struct, name, 0u)
+        : Type(Kind::Struct, NO_TYPE_ID, name, 0u, 1u, true, true, true)
+        , members_end_(0u)
+        , sealed_(false)
     {};
 
+    /// The copy shares the member types, so the member paths and ops are still valid.
     Struct(const Struct& other) = default;
+
     virtual ~Struct() = default;
 
+    /// The member holds an immutable snapshot of 'type': later changes in 'type' do not affect it.
     void add_member(const std::string& name, const Struct& type)
     {
         validate_member_creation(name);
-        members_.emplace(name, Member::ref(memory_size_, type));
-        memory_size_ += type.memory_size();
+        size_t offset = align_up(members_end_, type.alignment());
+        insert_member(Member::share(name, offset, type));
+    }
+
+    void add_member(const std::string& name, const Array& type)
+    {
+        validate_member_creation(name);
+        size_t offset = align_up(members_end_, type.alignment());
+        insert_member(Member::share(name, offset, type));
     }
 
     template<typename T>
     void add_member(const std::string& name, const T& t)
     {
         validate_member_creation(name);
-        auto insertion = members_.emplace(name, Member::create_ctype<T>(memory_size_, t));
-        memory_size_ += insertion.first->second.type().memory_size();
+        size_t offset = align_up(members_end_, alignof(T));
+        insert_member(Member::create_ctype<T>(name, offset, t));
     }
 
     template<typename T, typename... Args>
     void add_member(const std::string& name, Args&&... args)
     {
         validate_member_creation(name);
-        auto insertion = members_.emplace(name, Member::create_ctype<T>(memory_size_, std::forward<Args>(args)...));
-        memory_size_ += insertion.first->second.type().memory_size();
+        size_t offset = align_up(members_end_, alignof(T));
+        insert_member(Member::create_ctype<T>(name, offset, std::forward<Args>(args)...));
     }
 
     virtual std::unique_ptr<Type> clone() const override
@@ -102,53 +131,240 @@ public:
         return std::unique_ptr<Struct>(new Struct(*this));
     }
 
+    /// Copies the default image (the prototype of the trivially copyable members) and
+    /// builds only the non trivially copyable members, listed flat at any nesting level.
     virtual void build_object_at(uint8_t* location) const override
     {
-        for(auto&& it: members_)
+        copy_bytes(location, default_image_.data(), memory_size_);
+        for(auto&& op: construct_ops_)
         {
-            it.second.type().build_object_at(location + it.second.offset());
+            op.type->build_object_at(location + op.offset);
         }
     }
 
     virtual void destroy_object_at(uint8_t* location) const override
     {
-        for(auto&& it: members_)
+        for(auto it = destroy_ops_.rbegin(); it != destroy_ops_.rend(); ++it)
         {
-            it.second.type().destroy_object_at(location + it.second.offset());
+            it->type->destroy_object_at(location + it->offset);
         }
     }
 
+    /// Copies the whole object bitwise and copy constructs only the non trivially copyable members over it.
     virtual void copy_object(uint8_t* dest_location, uint8_t* src_location) const override
     {
-        for(auto&& it: members_)
+        copy_bytes(dest_location, src_location, memory_size_);
+        for(auto&& op: construct_ops_)
         {
-            it.second.type().copy_object(dest_location + it.second.offset(), src_location + it.second.offset());
+            op.type->copy_object(dest_location + op.offset, src_location + op.offset);
+        }
+    }
+
+    virtual void move_object(uint8_t* dest_location, uint8_t* src_location) const override
+    {
+        copy_bytes(dest_location, src_location, memory_size_);
+        for(auto&& op: construct_ops_)
+        {
+            op.type->move_object(dest_location + op.offset, src_location + op.offset);
         }
     }
 
     size_t member_size() const { return members_.size(); }
 
+    /// Members sorted by offset.
+    const std::vector<Member>& members() const { return members_; }
+    bool sealed() const { return sealed_; }
+
+    /// Finishes the struct definition: no more members can be added.
+    /// With LayoutPolicy::Compact the member offsets are recomputed to minimize the padding.
+    /// The member names are kept, only their physical placement changes.
+    /// A sealed struct is final: sealing it again throws MemberAddException.
+    void seal(LayoutPolicy policy = LayoutPolicy::Declared)
+    {
+        if(sealed_)
+        {
+            throw MemberAddException("Struct type '" + this->name() + "' is already sealed.");
+        }
+
+        if(policy == LayoutPolicy::Compact)
+        {
+            std::vector<uint32_t> order = declaration_order_;
+
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+            {
+                const Type& type_a = members_[a].type();
+                const Type& type_b = members_[b].type();
+                if(type_a.alignment() != type_b.alignment())
+                {
+                    return type_a.alignment() > type_b.alignment();
+                }
+                return type_a.memory_size() > type_b.memory_size();
+            });
+
+            std::vector<Member> members;
+            std::vector<uint32_t> new_positions(members_.size());
+            members.reserve(members_.size());
+            members_end_ = 0;
+            for(auto&& position: order)
+            {
+                Member& member = members_[position];
+                member.offset_ = align_up(members_end_, member.type().alignment());
+                members_end_ = member.offset_ + member.type().memory_size();
+                new_positions[position] = static_cast<uint32_t>(members.size());
+                members.push_back(std::move(member));
+            }
+            memory_size_ = align_up(members_end_, alignment_);
+
+            members_.swap(members);
+            for(auto&& position: declaration_order_)
+            {
+                position = new_positions[position];
+            }
+
+            default_image_.clear();
+            default_image_.resize(memory_size_, alignment_);
+            construct_ops_.clear();
+            destroy_ops_.clear();
+            serial_plan_.clear();
+            fingerprint_ = header_fingerprint();
+            for(uint32_t i = 0; i < members_.size(); i++)
+            {
+                update_prototype(i);
+                serial_plan_.append(members_[i].type().serial_plan(), members_[i].offset());
+                mix_member_fingerprint(members_[i]);
+            }
+
+            index_.clear();
+            for(uint32_t i = 0; i < members_.size(); i++)
+            {
+                index_.insert(members_[i].symbol().hash(), i);
+            }
+            rebuild_paths();
+        }
 
-    const Type& operator[](const std::string& name) const
+        // The member set is final: the lookups use a perfect hash, that checks a single candidate.
+        std::vector<uint64_t> hashes;
+        hashes.reserve(members_.size());
+        for(auto&& member: members_)
+        {
+            hashes.push_back(member.symbol().hash());
+        }
+        if(perfect_index_.build(hashes))
+        {
+            index_.clear();
+        }
+
+        sealed_ = true;
+    }
+
+    LayoutReport layout_report() const
     {
-        if(members_.find(name) == members_.end())
+        size_t declared_end = 0;
+        size_t members_memory = 0;
+        for(auto&& position: declaration_order_)
         {
-            throw MemberAccessException("Struct type '" + this->name() + "' has no member '" + name + "'.");
+            const Type& type = members_[position].type();
+            declared_end = align_up(declared_end, type.alignment()) + type.memory_size();
+            members_memory += type.memory_size();
         }
 
-        return members_.at(name).type();
+        LayoutReport report;
+        report.memory_size = memory_size_;
+        report.declared_memory_size = align_up(declared_end, alignment_);
+        report.padding = memory_size_ - members_memory;
+        report.saved_bytes = report.declared_memory_size - memory_size_;
+        return report;
     }
 
-    const Member* member(const std::string& name) const
+
+    const Type& operator[](StringView name) const
     {
-        auto it = members_.find(name);
-        return it != members_.end() ? &it->second : nullptr;
+        const Member* member = this->member(name);
+        if(!member)
+        {
+            throw MemberAccessException("Struct type '" + this->name() + "' has no member '" + name.to_string() + "'.");
+        }
+
+        return member->type();
+    }
+
+    const Type& operator[](const Symbol& name) const
+    {
+        const Member* member = this->member(name);
+        if(!member)
+        {
+            throw MemberAccessException("Struct type '" + this->name() + "' has no member '" + name.name() + "'.");
+        }
+
+        return member->type();
+    }
+
+    /// As operator[], but returns nullptr if there is no member 'name'.
+    const Type* find(StringView name) const
+    {
+        const Member* member = this->member(name);
+        return member ? &member->type() : nullptr;
     }
 
+    const Type* find(const Symbol& name) const
+    {
+        const Member* member = this->member(name);
+        return member ? &member->type() : nullptr;
+    }
+
+    const Member* member(StringView name) const
+    {
+        return find_member(hash_name(name.data(), name.size()), [&](uint32_t candidate)
+        {
+            return StringView(members_[candidate].name()) == name;
+        });
+    }
+
+    /// Lookup by an interned name: its hash is already computed and the candidates are compared by pointer.
+    const Member* member(const Symbol& name) const
+    {
+        return find_member(name.hash(), [&](uint32_t candidate)
+        {
+            return members_[candidate].symbol() == name;
+        });
+    }
+
+    /// Member placed in the dotted 'path' ("inner.values"), at any nesting level, or nullptr.
+    /// Resolved by a single lookup in the flattened paths of the struct.
+    const MemberPath* member_path(StringView path) const
+    {
+        uint32_t position = path_index_.find(hash_name(path.data(), path.size()), [&](uint32_t candidate)
+        {
+            return StringView(paths_[candidate].path) == path;
+        });
+        return position != NameIndex::npos ? &paths_[position] : nullptr;
+    }
+
+    /// Paths of all the members, also the members of nested structs.
+    const std::vector<MemberPath>& member_paths() const { return paths_; }
+
+    /// Creates an accessor to the member placed in the dotted 'path'. See Accessor.hpp.
+    template <typename T>
+    Accessor<T> path(const std::string& path) const;
+
 private:
+    template <typename Equal>
+    const Member* find_member(uint64_t hash, Equal&& equal) const
+    {
+        uint32_t position = perfect_index_.empty()
+            ? index_.find(hash, std::forward<Equal>(equal))
+            : perfect_index_.find(hash, std::forward<Equal>(equal));
+        return position != NameIndex::npos ? &members_[position] : nullptr;
+    }
+
     bool validate_member_creation(const std::string& name) const
     {
-        if(members_.find(name) != members_.end())
+        if(sealed_)
+        {
+            throw MemberAddException("Struct type '" + this->name() + "' is sealed, member '" + name + "' can not be added.");
+        }
+
+        if(member(name))
         {
             throw MemberAddException("Struct type '" + this->name() + "' has already a member called '" + name + "'.");
         }
@@ -156,7 +372,142 @@ private:
         return true;
     }
 
-    std::map<std::string, Member> members_;
+    // Places the struct end and alignment as the compiler does:
+    // the memory size is rounded up to the strictest member alignment.
+    void insert_member(Member&& member)
+    {
+        const uint32_t position = static_cast<uint32_t>(members_.size());
+        members_.push_back(std::move(member));
+
+        const Member& inserted = members_.back();
+        index_.insert(inserted.symbol().hash(), position);
+        declaration_order_.push_back(position);
+
+        members_end_ = inserted.offset() + inserted.type().memory_size();
+        alignment_ = std::max(alignment_, inserted.type().alignment());
+        memory_size_ = align_up(members_end_, alignment_);
+        trivially_copyable_ = trivially_copyable_ && inserted.type().is_trivially_copyable();
+        trivially_destructible_ = trivially_destructible_ && inserted.type().is_trivially_destructible();
+        nothrow_movable_ = nothrow_movable_ && inserted.type().is_nothrow_movable();
+
+        default_image_.resize(memory_size_, alignment_);
+        update_prototype(position);
+        serial_plan_.append(inserted.type().serial_plan(), inserted.offset());
+        mix_member_fingerprint(inserted);
+        add_paths(inserted);
+    }
+
+    // The members are mixed in their storage order, so a compact layout mixes them again.
+    void mix_member_fingerprint(const Member& member)
+    {
+        fingerprint_ = mix_fingerprint(fingerprint_, member.symbol().hash());
+        fingerprint_ = mix_fingerprint(fingerprint_, member.offset());
+        fingerprint_ = mix_fingerprint(fingerprint_, member.type().fingerprint());
+    }
+
+    // A nested struct brings its own paths, prefixed by the member name.
+    void add_paths(const Member& member)
+    {
+        insert_path(member.name(), member.offset(), member.type());
+        if(member.type().kind() == Kind::Struct)
+        {
+            for(auto&& inner: static_cast<const Struct&>(member.type()).paths_)
+            {
+                insert_path(member.name() + "." + inner.path, member.offset() + inner.offset, *inner.type);
+            }
+        }
+    }
+
+    void insert_path(std::string path, size_t offset, const Type& type)
+    {
+        path_index_.insert(hash_name(path.data(), path.size()), static_cast<uint32_t>(paths_.size()));
+        paths_.push_back(MemberPath{std::move(path), offset, &type});
+    }
+
+    void rebuild_paths()
+    {
+        paths_.clear();
+        path_index_.clear();
+        for(auto&& position: declaration_order_)
+        {
+            add_paths(members_[position]);
+        }
+    }
+
+    // The default image holds the default instance of the trivially copyable members,
+    // also the ones inside of nested structs, so they are built by a single memcpy from it.
+    // The rest of members are built one by one by the construct ops.
+    void update_prototype(uint32_t position)
+    {
+        const Member& member = members_[position];
+        const Type& type = member.type();
+        if(type.is_trivially_copyable())
+        {
+            type.build_object_at(default_image_.data() + member.offset());
+        }
+        else if(type.kind() == Kind::Struct)
+        {
+            const Struct& inner = static_cast<const Struct&>(type);
+            copy_bytes(default_image_.data() + member.offset(), inner.default_image_.data(), inner.memory_size());
+        }
+        add_ops(member);
+    }
+
+    // A nested struct brings its own ops, displaced by the member offset:
+    // no op refers to a struct, so the ops are run without recursion.
+    void add_ops(const Member& member)
+    {
+        const Type& type = member.type();
+        if(type.kind() == Kind::Struct)
+        {
+            const Struct& inner = static_cast<const Struct&>(type);
+            for(auto&& op: inner.construct_ops_)
+            {
+                construct_ops_.push_back(MemberOp{member.offset() + op.offset, op.type});
+            }
+            for(auto&& op: inner.destroy_ops_)
+            {
+                destroy_ops_.push_back(MemberOp{member.offset() + op.offset, op.type});
+            }
+            return;
+        }
+
+        if(!type.is_trivially_copyable())
+        {
+            construct_ops_.push_back(MemberOp{member.offset(), &type});
+        }
+        if(!type.is_trivially_destructible())
+        {
+            destroy_ops_.push_back(MemberOp{member.offset(), &type});
+        }
+    }
+
+    static void copy_bytes(uint8_t* dest, const uint8_t* src, size_t size)
+    {
+        if(size > 0)
+        {
+            std::memcpy(dest, src, size);
+        }
+    }
+
+    std::vector<Member> members_; //Sorted by offset
+    NameIndex index_; //Name to members_ position, while not sealed
+    PerfectIndex perfect_index_; //Name to members_ position, once sealed
+    std::vector<uint32_t> declaration_order_; //members_ positions in declaration order
+    std::vector<MemberPath> paths_; //Members at any nesting level
+    NameIndex path_index_; //Dotted path to paths_ position
+    // Member of any nesting level that is not a struct, placed at 'offset' from this struct.
+    struct MemberOp
+    {
+        size_t offset;
+        const Type* type;
+    };
+
+    AlignedBuffer default_image_;
+    std::vector<MemberOp> construct_ops_; //Non trivially copyable members, by offset
+    std::vector<MemberOp> destroy_ops_; //Non trivially destructible members, by offset
+    size_t members_end_; //Without tail padding
+    bool sealed_;
 };
 
 } //namespace rt
@@ -0,0 +1,88 @@
+#ifndef RT__SYMBOL_HPP_
+#define RT__SYMBOL_HPP_
+
+#include <runtypes/NameIndex.hpp>
+#include <runtypes/StringView.hpp>
+
+#include <deque>
+#include <mutex>
+#include <string>
+
+namespace rt
+{
+
+//=========================== SymbolTable =============================
+/// Process wide table of interned names. Each name is stored once and never released,
+/// so the entries keep their address for the whole process lifetime.
+class SymbolTable
+{
+public:
+    struct Entry
+    {
+        std::string name;
+        uint64_t hash;
+    };
+
+    static SymbolTable& instance()
+    {
+        static SymbolTable table;
+        return table;
+    }
+
+    const Entry& intern(StringView name)
+    {
+        const uint64_t hash = hash_name(name.data(), name.size());
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint32_t position = index_.find(hash, [&](uint32_t candidate)
+        {
+            return entries_[candidate].hash == hash && StringView(entries_[candidate].name) == name;
+        });
+
+        if(position != NameIndex::npos)
+        {
+            return entries_[position];
+        }
+
+        entries_.push_back(Entry{name.to_string(), hash});
+        index_.insert(hash, static_cast<uint32_t>(entries_.size() - 1));
+        return entries_.back();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+private:
+    SymbolTable() = default;
+
+    mutable std::mutex mutex_;
+    std::deque<Entry> entries_; //Stable addresses
+    NameIndex index_; //Name to entries_ position
+};
+
+//=========================== Symbol =============================
+/// Interned name. Two symbols are equal only if they point to the same entry,
+/// so they are compared by pointer instead of by their characters.
+class Symbol
+{
+public:
+    explicit Symbol(StringView name)
+        : entry_(&SymbolTable::instance().intern(name))
+    {}
+
+    const std::string& name() const { return entry_->name; }
+    uint64_t hash() const { return entry_->hash; }
+
+    bool operator==(const Symbol& other) const { return entry_ == other.entry_; }
+    bool operator!=(const Symbol& other) const { return entry_ != other.entry_; }
+
+private:
+    const SymbolTable::Entry* entry_;
+};
+
+} //namespace rt
+
+#endif //RT__SYMBOL_HPP_
@@ -0,0 +1,206 @@
+#ifndef RT__TABLE_HPP_
+#define RT__TABLE_HPP_
+
+#include <runtypes/DataArray.hpp>
+#include <runtypes/Exception.hpp>
+#include <runtypes/NameIndex.hpp>
+
+namespace rt
+{
+
+//=========================== Column =============================
+/// Contiguous view of the values of a column.
+template <typename T>
+class Column
+{
+public:
+    Column(T* data, size_t size)
+        : data_(data)
+        , size_(size)
+    {}
+
+    T* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    T* begin() const { return data_; }
+    T* end() const { return data_ + size_; }
+
+    T& operator[](size_t index) const { return data_[index]; }
+
+private:
+    T* data_;
+    size_t size_;
+};
+
+class Table;
+
+//=========================== TableRow =============================
+/// Access to the values of a row, spread among the table columns.
+/// The columns are accessed by their dotted paths ("inner.x").
+class TableRow
+{
+public:
+    WritableDataRef operator[](StringView path) const;
+
+    size_t index() const { return index_; }
+
+private:
+    friend class Table;
+
+    TableRow(Table& table, size_t index)
+        : table_(table)
+        , index_(index)
+    {}
+
+    Table& table_;
+    size_t index_;
+};
+
+//=========================== Table =============================
+/// Columnar storage of the instances of a struct:
+/// each non struct member, also the ones of nested structs, is stored in its own contiguous column.
+class Table
+{
+public:
+    Table(const Struct& type, Allocator& allocator = HeapAllocator::instance())
+        : type_(type)
+        , size_(0)
+    {
+        add_columns(type, "", allocator);
+    }
+
+    const Struct& type() const { return type_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_t column_size() const { return columns_.size(); }
+
+    /// Dotted paths of the columns, in offset order of the struct.
+    const std::vector<std::string>& column_paths() const { return paths_; }
+
+    template <typename T>
+    Column<T> column(StringView path)
+    {
+        DataArray& values = find_column<T>(path);
+        return Column<T>(reinterpret_cast<T*>(values.memory()), size_);
+    }
+
+    template <typename T>
+    Column<const T> column(StringView path) const
+    {
+        const DataArray& values = const_cast<Table*>(this)->find_column<T>(path);
+        return Column<const T>(reinterpret_cast<const T*>(values.memory()), size_);
+    }
+
+    TableRow row(size_t index)
+    {
+        return TableRow(*this, index);
+    }
+
+    TableRow operator[](size_t index)
+    {
+        return row(index);
+    }
+
+    void reserve(size_t capacity)
+    {
+        for(auto&& column: columns_)
+        {
+            column.reserve(capacity);
+        }
+    }
+
+    /// Appends a row with the default values of the struct.
+    TableRow push_back()
+    {
+        for(auto&& column: columns_)
+        {
+            column.push_back();
+        }
+        return row(size_++);
+    }
+
+    void resize(size_t size)
+    {
+        for(auto&& column: columns_)
+        {
+            column.resize(size);
+        }
+        size_ = size;
+    }
+
+    void clear()
+    {
+        resize(0);
+    }
+
+    /// Column values, as a data array of the member type.
+    DataArray& values(StringView path)
+    {
+        return columns_[column_position(path)];
+    }
+
+    const DataArray& values(StringView path) const
+    {
+        return columns_[column_position(path)];
+    }
+
+private:
+    void add_columns(const Struct& type, const std::string& prefix, Allocator& allocator)
+    {
+        for(auto&& member: type.members())
+        {
+            const std::string path = prefix + member.name();
+            if(member.type().kind() == Kind::Struct)
+            {
+                add_columns(static_cast<const Struct&>(member.type()), path + ".", allocator);
+            }
+            else
+            {
+                index_.insert(hash_name(path.data(), path.size()), static_cast<uint32_t>(paths_.size()));
+                paths_.push_back(path);
+                columns_.emplace_back(member.type(), allocator);
+            }
+        }
+    }
+
+    size_t column_position(StringView path) const
+    {
+        uint32_t position = index_.find(hash_name(path.data(), path.size()), [&](uint32_t candidate)
+        {
+            return StringView(paths_[candidate]) == path;
+        });
+        if(position == NameIndex::npos)
+        {
+            throw MemberAccessException("Table of type '" + type_.name() + "' has no column '" + path.to_string() + "'.");
+        }
+        return position;
+    }
+
+    template <typename T>
+    DataArray& find_column(StringView path)
+    {
+        DataArray& values = columns_[column_position(path)];
+        const Type& type = values.type();
+        if(!type.is<T>())
+        {
+            throw DataAccessException("Type '" + type.name() + "' differs from '" + typeid(T).name() + "'.");
+        }
+        return values;
+    }
+
+    const Struct& type_;
+    std::vector<std::string> paths_;
+    NameIndex index_; //Column path to paths_ position
+    std::vector<DataArray> columns_;
+    size_t size_;
+};
+
+inline WritableDataRef TableRow::operator[](StringView path) const
+{
+    return table_.values(path).at(index_);
+}
+
+} //namespace rt
+
+#endif //RT__TABLE_HPP_
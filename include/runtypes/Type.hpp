@@ -1,6 +1,11 @@
 #ifndef RT__TYPE_HPP_
 #define RT__TYPE_HPP_
 
+#include <runtypes/NameIndex.hpp>
+#include <runtypes/SerialPlan.hpp>
+#include <runtypes/TypeId.hpp>
+
+#include <atomic>
 #include <cinttypes>
 #include <string>
 #include <memory>
@@ -8,12 +13,20 @@
 namespace rt
 {
 
+//=========================== Alignment =============================
+inline size_t align_up(size_t offset, size_t alignment)
+{
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
 //=========================== Kind =============================
 enum class Kind
 {
-    Undefined, CType, Struct,
+    Undefined, CType, Struct, Array,
 };
 
+class TypeRef;
+
 //=========================== Type =============================
 class Type
 {
@@ -25,27 +38,205 @@ public:
     virtual void build_object_at(uint8_t* location) const = 0;
     virtual void destroy_object_at(uint8_t* location) const = 0;
     virtual void copy_object(uint8_t* dest_location, uint8_t* src_location) const = 0;
+    /// Builds at 'dest_location' an object taking the resources of the 'src_location' object.
+    /// The source object still must be destroyed.
+    virtual void move_object(uint8_t* dest_location, uint8_t* src_location) const = 0;
 
     Kind kind() const { return kind_; };
+    TypeId id() const { return id_; }
     const std::string& name() const { return name_; };
     size_t memory_size() const { return memory_size_; }
+    size_t alignment() const { return alignment_; }
+
+    /// Checks if the type represents the C++ type 'T'.
+    template <typename T>
+    bool is() const { return id_ == type_id<T>(); }
+
+    /// The object can be copied with memcpy.
+    bool is_trivially_copyable() const { return trivially_copyable_; }
+    /// The object destruction does nothing.
+    bool is_trivially_destructible() const { return trivially_destructible_; }
+    /// move_object does not throw.
+    bool is_nothrow_movable() const { return nothrow_movable_; }
+
+    /// Serialization operations of the type. See Serialization.hpp.
+    const SerialPlan& serial_plan() const { return serial_plan_; }
+
+    /// Hash of the definition: the name and, for structs and arrays, the members and elements.
+    /// It is computed as the type is defined, so comparing two definitions costs the same at any size.
+    uint64_t fingerprint() const { return fingerprint_; }
+
+    /// Checks if the instances of 'other' are instances of this type: it is this type
+    /// or it has the same definition, as the snapshot of a nested struct and its original.
+    bool equivalent(const Type& other) const
+    {
+        return this == &other
+            || (fingerprint_ == other.fingerprint_ && kind_ == other.kind_ && id_ == other.id_
+                && memory_size_ == other.memory_size_ && alignment_ == other.alignment_);
+    }
+
+    /// Name for the error messages.
+    std::string display_name() const
+    {
+        return name_.empty() ? "<unnamed>" : "'" + name_ + "'";
+    }
 
 protected:
-    Type(Kind kind, const std::string& name, size_t memory_size)
+    Type(Kind kind, TypeId id, const std::string& name, size_t memory_size, size_t alignment,
+        bool trivially_copyable, bool trivially_destructible, bool nothrow_movable)
         : kind_(kind)
+        , id_(id)
         , name_(name)
         , memory_size_(memory_size)
+        , alignment_(alignment)
+        , trivially_copyable_(trivially_copyable)
+        , trivially_destructible_(trivially_destructible)
+        , nothrow_movable_(nothrow_movable)
+        , fingerprint_(header_fingerprint())
+        , references_(0)
+    {}
+
+    /// The copy is not owned by the type refs of 'other'.
+    Type(const Type& other)
+        : kind_(other.kind_)
+        , id_(other.id_)
+        , name_(other.name_)
+        , memory_size_(other.memory_size_)
+        , alignment_(other.alignment_)
+        , trivially_copyable_(other.trivially_copyable_)
+        , trivially_destructible_(other.trivially_destructible_)
+        , nothrow_movable_(other.nothrow_movable_)
+        , serial_plan_(other.serial_plan_)
+        , fingerprint_(other.fingerprint_)
+        , references_(0)
     {}
 
+    /// Fingerprint of the kind, id and name, where the derived types mix their definition.
+    uint64_t header_fingerprint() const
+    {
+        return mix_fingerprint(mix_fingerprint(static_cast<uint64_t>(kind_), id_), hash_name(name_.data(), name_.size()));
+    }
+
+    static uint64_t mix_fingerprint(uint64_t fingerprint, uint64_t value)
+    {
+        fingerprint = (fingerprint ^ value) * 0x9E3779B97F4A7C15ULL;
+        return fingerprint ^ (fingerprint >> 29);
+    }
+
+    Type& operator=(const Type& other)
+    {
+        kind_ = other.kind_;
+        id_ = other.id_;
+        name_ = other.name_;
+        memory_size_ = other.memory_size_;
+        alignment_ = other.alignment_;
+        trivially_copyable_ = other.trivially_copyable_;
+        trivially_destructible_ = other.trivially_destructible_;
+        nothrow_movable_ = other.nothrow_movable_;
+        serial_plan_ = other.serial_plan_;
+        fingerprint_ = other.fingerprint_;
+        return *this;
+    }
+
 private:
+    friend class TypeRef;
+
     Kind kind_;
+    TypeId id_;
     std::string name_;
 
 protected:
     size_t memory_size_;
+    size_t alignment_;
+    bool trivially_copyable_;
+    bool trivially_destructible_;
+    bool nothrow_movable_;
+    SerialPlan serial_plan_;
+    uint64_t fingerprint_;
+
+private:
+    mutable std::atomic<uint32_t> references_; //Type refs owning the type, 0 if it is not shared
+};
+
+//=========================== TypeRef =============================
+/// Shared ownership of a type by an intrusive reference count.
+/// A shared type is immutable: it is only reached through const references,
+/// so it can be read from several threads without locks and copied by sharing it.
+class TypeRef
+{
+public:
+    TypeRef()
+        : type_(nullptr)
+    {}
+
+    explicit TypeRef(std::unique_ptr<Type> type)
+        : type_(type.release())
+    {
+        acquire();
+    }
+
+    TypeRef(const TypeRef& other)
+        : type_(other.type_)
+    {
+        acquire();
+    }
+
+    TypeRef(TypeRef&& other) noexcept
+        : type_(other.type_)
+    {
+        other.type_ = nullptr;
+    }
+
+    TypeRef& operator=(TypeRef other) noexcept
+    {
+        std::swap(type_, other.type_);
+        return *this;
+    }
+
+    ~TypeRef()
+    {
+        if(type_ && type_->references_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete type_;
+        }
+    }
+
+    /// Shares 'type' if it is already shared, or an immutable snapshot of it otherwise,
+    /// as a type owned by the caller, which can still be modified or destroyed.
+    static TypeRef share(const Type& type)
+    {
+        if(type.references_.load(std::memory_order_relaxed) > 0)
+        {
+            return TypeRef(&type);
+        }
+        return TypeRef(type.clone());
+    }
+
+    const Type& operator*() const { return *type_; }
+    const Type* operator->() const { return type_; }
+    const Type* get() const { return type_; }
+    explicit operator bool() const { return type_ != nullptr; }
+
+    size_t use_count() const { return type_ ? type_->references_.load(std::memory_order_relaxed) : 0; }
+
+private:
+    explicit TypeRef(const Type* type)
+        : type_(type)
+    {
+        acquire();
+    }
+
+    void acquire()
+    {
+        if(type_)
+        {
+            type_->references_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const Type* type_;
 };
 
 } //namespace rt
 
 #endif //RT__TYPE_HPP_
-
@@ -0,0 +1,73 @@
+#ifndef RT__TYPE_ID_HPP_
+#define RT__TYPE_ID_HPP_
+
+#include <cinttypes>
+
+namespace rt
+{
+
+//=========================== TypeId =============================
+/// Identifier of a C++ type, checked with a single integer comparison.
+/// Registered types have a fixed small identifier, the same in every process,
+/// so it can be used to check the types of shared-memory data without RTTI.
+/// The rest of types are identified by the address of a tag, unique in the process.
+typedef uintptr_t TypeId;
+
+/// Identifier of the types with no C++ type, as structs and arrays.
+const TypeId NO_TYPE_ID = 0;
+
+template <typename T>
+struct TypeIdRegistry
+{
+    static constexpr TypeId value = NO_TYPE_ID;
+};
+
+template <typename T>
+struct TypeIdTag
+{
+    static const char tag;
+};
+
+template <typename T>
+const char TypeIdTag<T>::tag = 0;
+
+template <typename T>
+inline TypeId type_id()
+{
+    const TypeId registered = TypeIdRegistry<T>::value;
+    return registered != NO_TYPE_ID ? registered : reinterpret_cast<TypeId>(&TypeIdTag<T>::tag);
+}
+
+/// Registers a fixed identifier for a type. Identifiers below 256 are reserved by runtypes.
+/// Must be used at global scope.
+#define RT_REGISTER_TYPE_ID(TYPE, ID) \
+    namespace rt { \
+        template <> \
+        struct TypeIdRegistry<TYPE> \
+        { \
+            static constexpr TypeId value = ID; \
+        }; \
+    }
+
+} //namespace rt
+
+RT_REGISTER_TYPE_ID(bool, 1)
+RT_REGISTER_TYPE_ID(char, 2)
+RT_REGISTER_TYPE_ID(signed char, 3)
+RT_REGISTER_TYPE_ID(unsigned char, 4)
+RT_REGISTER_TYPE_ID(short, 5)
+RT_REGISTER_TYPE_ID(unsigned short, 6)
+RT_REGISTER_TYPE_ID(int, 7)
+RT_REGISTER_TYPE_ID(unsigned int, 8)
+RT_REGISTER_TYPE_ID(long, 9)
+RT_REGISTER_TYPE_ID(unsigned long, 10)
+RT_REGISTER_TYPE_ID(long long, 11)
+RT_REGISTER_TYPE_ID(unsigned long long, 12)
+RT_REGISTER_TYPE_ID(float, 13)
+RT_REGISTER_TYPE_ID(double, 14)
+RT_REGISTER_TYPE_ID(long double, 15)
+RT_REGISTER_TYPE_ID(wchar_t, 16)
+RT_REGISTER_TYPE_ID(char16_t, 17)
+RT_REGISTER_TYPE_ID(char32_t, 18)
+
+#endif //RT__TYPE_ID_HPP_
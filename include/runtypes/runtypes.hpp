@@ -3,5 +3,12 @@
 
 // These files includes all public API
 #include <runtypes/Data.hpp>
+#include <runtypes/DataArray.hpp>
+#include <runtypes/Table.hpp>
+#include <runtypes/Accessor.hpp>
+#include <runtypes/Segment.hpp>
+#include <runtypes/PoolAllocator.hpp>
+#include <runtypes/Arena.hpp>
+#include <runtypes/Serialization.hpp>
 
 #endif //RT__RUNTYPES_HPP_
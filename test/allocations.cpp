@@ -0,0 +1,176 @@
+#include <runtypes/runtypes.hpp>
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<size_t> allocation_count(0);
+
+// Counts the allocations done while it is alive.
+class AllocationCounter
+{
+public:
+    AllocationCounter()
+        : start_(allocation_count.load())
+    {}
+
+    size_t count() const { return allocation_count.load() - start_; }
+
+private:
+    size_t start_;
+};
+
+} //namespace
+
+// The replacements pair malloc with free, but GCC checks the inlined calls against the default operators.
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size)
+{
+    allocation_count++;
+    if(void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    allocation_count++;
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+SCENARIO("allocations test")
+{
+    // Names longer than the small string buffer: a std::string temporary would allocate.
+    rt::Struct inner("inner");
+    inner.add_member<int>("an_identifier_longer_than_sso", 7);
+
+    rt::Struct type("outer");
+    type.add_member<float>("a_value_name_longer_than_sso", 1.5f);
+    type.add_member("an_inner_struct_longer_than_sso", inner);
+
+    GIVEN("an allocation counter")
+    {
+        THEN("it counts the allocations")
+        {
+            AllocationCounter counter;
+            std::string name = "a_string_longer_than_the_small_buffer";
+            REQUIRE(counter.count() == 1);
+        }
+    }
+
+    GIVEN("a data instance")
+    {
+        rt::Data data(type);
+        const rt::Data& const_data = data;
+
+        THEN("the lookups by literal do not allocate")
+        {
+            AllocationCounter counter;
+
+            int id = data["an_inner_struct_longer_than_sso"]["an_identifier_longer_than_sso"].get<int>();
+            data["a_value_name_longer_than_sso"].set(2.5f);
+            float value = const_data["a_value_name_longer_than_sso"].get<float>();
+            bool found = static_cast<bool>(data.find("a_missing_member_longer_than_sso"));
+            const rt::Member* member = type.member("a_value_name_longer_than_sso");
+            const rt::Type& member_type = type["an_inner_struct_longer_than_sso"];
+
+            REQUIRE(counter.count() == 0);
+            REQUIRE(id == 7);
+            REQUIRE(value == 2.5f);
+            REQUIRE_FALSE(found);
+            REQUIRE(member != nullptr);
+            REQUIRE(&member_type == &type.member("an_inner_struct_longer_than_sso")->type());
+        }
+
+        THEN("the lookups by std::string do not allocate")
+        {
+            const std::string name = "a_value_name_longer_than_sso";
+
+            AllocationCounter counter;
+            float value = data[name].get<float>();
+            REQUIRE(counter.count() == 0);
+            REQUIRE(value == 1.5f);
+        }
+
+        THEN("the lookups by an interned symbol do not allocate")
+        {
+            const rt::Symbol name("a_value_name_longer_than_sso");
+            const rt::Symbol same("a_value_name_longer_than_sso"); // Already interned
+
+            AllocationCounter counter;
+            float value = data[name].get<float>();
+            const rt::Symbol again("a_value_name_longer_than_sso");
+            REQUIRE(counter.count() == 0);
+            REQUIRE(value == 1.5f);
+            REQUIRE(again == same);
+        }
+    }
+
+    GIVEN("a small type")
+    {
+        rt::Struct small;
+        small.add_member<double>("x", 1.0);
+        small.add_member<double>("y", 2.0);
+
+        THEN("the data instances are built without allocations")
+        {
+            AllocationCounter counter;
+            rt::Data data(small);
+            rt::Data copy(data);
+            rt::Data moved(std::move(copy));
+            REQUIRE(counter.count() == 0);
+            REQUIRE(moved["y"].get<double>() == 2.0);
+        }
+    }
+
+    GIVEN("a table")
+    {
+        rt::Table table(type);
+        table.push_back();
+
+        THEN("the column lookups by literal do not allocate")
+        {
+            AllocationCounter counter;
+            table[0]["an_inner_struct_longer_than_sso.an_identifier_longer_than_sso"].set(9);
+            rt::Column<int> ids = table.column<int>("an_inner_struct_longer_than_sso.an_identifier_longer_than_sso");
+            REQUIRE(counter.count() == 0);
+            REQUIRE(ids[0] == 9);
+        }
+    }
+}
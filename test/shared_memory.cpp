@@ -0,0 +1,162 @@
+#include <runtypes/runtypes.hpp>
+
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+
+namespace
+{
+
+const size_t SEGMENT_SIZE = 4096;
+
+// Each process defines the type by itself.
+struct RecordType
+{
+    RecordType()
+        : point("point")
+        , record("record")
+    {
+        point.add_member<double>("x");
+        point.add_member<double>("y");
+
+        record.add_member<uint32_t>("id");
+        record.add_member("position", point);
+        record.add_member<bool>("valid");
+        record.add_member<std::array<char, 16>>("tag");
+    }
+
+    rt::Struct point;
+    rt::Struct record;
+};
+
+uint8_t* map_segment(const std::string& name, int flags)
+{
+    int fd = shm_open(name.c_str(), flags, 0600);
+    if(fd < 0)
+    {
+        return nullptr;
+    }
+
+    if((flags & O_CREAT) && ftruncate(fd, SEGMENT_SIZE) != 0)
+    {
+        close(fd);
+        return nullptr;
+    }
+
+    void* memory = mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    return memory != MAP_FAILED ? static_cast<uint8_t*>(memory) : nullptr;
+}
+
+// Consumer process: checks the producer records and answers writing into them.
+int consume(const std::string& name, size_t first_offset, size_t second_offset)
+{
+    RecordType type;
+    const rt::Struct& record = type.record;
+    uint8_t* memory = map_segment(name, O_RDWR);
+    if(!memory)
+    {
+        return 1;
+    }
+
+    rt::Segment segment(memory, SEGMENT_SIZE);
+    rt::DataView first(record, segment.address(first_offset));
+    rt::DataView second(record, segment.address(second_offset));
+
+    bool ok = first["id"].get<uint32_t>() == 1
+        && first["position"]["x"].get<double>() == 1.5
+        && first["valid"].get<bool>()
+        && second["id"].get<uint32_t>() == 2
+        && second["position"]["y"].get<double>() == -3.0
+        && std::string(second["tag"].get<std::array<char, 16>>().data()) == "second";
+
+    second["valid"].set(true);
+    munmap(memory, SEGMENT_SIZE);
+    return ok ? 0 : 2;
+}
+
+} //namespace
+
+SCENARIO("shared memory test")
+{
+    GIVEN("a shared-memory segment")
+    {
+        const std::string name = "/runtypes_test_" + std::to_string(getpid());
+        uint8_t* memory = map_segment(name, O_CREAT | O_RDWR);
+        REQUIRE(memory != nullptr);
+
+        RecordType type;
+        const rt::Struct& record = type.record;
+        rt::Segment segment(memory, SEGMENT_SIZE);
+
+        WHEN("records are created in the segment")
+        {
+            rt::Data first(record, segment);
+            rt::Data second(record, segment);
+
+            THEN("records are packed and aligned into the segment")
+            {
+                REQUIRE(first.memory() >= memory);
+                REQUIRE(second.memory() + record.memory_size() <= memory + SEGMENT_SIZE);
+                REQUIRE(segment.offset(second.memory()) == rt::align_up(record.memory_size(), record.alignment()));
+                REQUIRE(segment.used() == 2 * record.memory_size());
+                REQUIRE(reinterpret_cast<uintptr_t>(second.memory()) % record.alignment() == 0);
+            }
+
+            first["id"].set<uint32_t>(1);
+            first["position"]["x"].set(1.5);
+            first["valid"].set(true);
+
+            second["id"].set<uint32_t>(2);
+            second["position"]["y"].set(-3.0);
+            second["tag"].set(std::array<char, 16>{{'s', 'e', 'c', 'o', 'n', 'd'}});
+
+            WHEN("other process reads and writes the records")
+            {
+                size_t first_offset = segment.offset(first.memory());
+                size_t second_offset = segment.offset(second.memory());
+
+                pid_t pid = fork();
+                if(pid == 0)
+                {
+                    _exit(consume(name, first_offset, second_offset));
+                }
+
+                int status = -1;
+                REQUIRE(waitpid(pid, &status, 0) == pid);
+
+                THEN("the records are read from the other process without copies")
+                {
+                    REQUIRE(WIFEXITED(status));
+                    REQUIRE(WEXITSTATUS(status) == 0);
+                }
+
+                THEN("the other process writings are seen")
+                {
+                    REQUIRE(second["valid"].get<bool>());
+                }
+            }
+        }
+
+        WHEN("the segment is full")
+        {
+            rt::Struct big("big");
+            big.add_member<std::array<uint8_t, SEGMENT_SIZE>>("bytes");
+            rt::Data filled(big, segment);
+
+            REQUIRE_THROWS_AS(rt::Data(record, segment), rt::AllocationException);
+
+            segment.reset();
+            REQUIRE(segment.available() == SEGMENT_SIZE);
+        }
+
+        munmap(memory, SEGMENT_SIZE);
+        shm_unlink(name.c_str());
+    }
+}
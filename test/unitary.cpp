@@ -4,6 +4,73 @@
 #include <catch2/catch.hpp>
 
 #include <array>
+#include <cstddef>
+#include <map>
+#include <vector>
+
+struct CompiledInner
+{
+    bool b;
+    int64_t i64;
+    char c;
+    double d;
+    int16_t i16;
+};
+
+struct CompiledOuter
+{
+    char c;
+    CompiledInner inner;
+    uint16_t u16;
+    float f;
+};
+
+struct alignas(64) OverAligned
+{
+    char c;
+};
+
+struct RegisteredPod
+{
+    int a;
+    float b;
+};
+
+RT_REGISTER_TYPE_ID(RegisteredPod, 1000)
+
+// Counts the living instances.
+struct Tracked
+{
+    static int alive;
+
+    Tracked() { alive++; }
+    Tracked(const Tracked&) noexcept { alive++; }
+    Tracked& operator=(const Tracked&) = default;
+    ~Tracked() { alive--; }
+};
+
+int Tracked::alive = 0;
+
+// Counts the living instances, its copy throws once 'copies_left' reaches 0.
+struct ThrowingCopy
+{
+    static int alive;
+    static int copies_left;
+
+    ThrowingCopy() { alive++; }
+    ThrowingCopy(const ThrowingCopy&)
+    {
+        if(copies_left-- == 0)
+        {
+            throw std::runtime_error("copy failed");
+        }
+        alive++;
+    }
+    ~ThrowingCopy() { alive--; }
+};
+
+int ThrowingCopy::alive = 0;
+int ThrowingCopy::copies_left = 0;
 
 template <typename T>
 void test_data(rt::WritableDataRef&& d, const T& value, const T& set_value)
@@ -42,6 +109,8 @@ void test_c_type(const std::string& name_type, const T& value, const T& set_valu
             REQUIRE(t.name() == typeid(T).name());
             REQUIRE(t.memory_size() == sizeof(T));
             REQUIRE(t.hash_code() == typeid(T).hash_code());
+            REQUIRE(t.id() == rt::type_id<T>());
+            REQUIRE(t.template is<T>());
             REQUIRE(t.base_instance() == value); //This checks works only with comparable types
         }
 
@@ -62,7 +131,6 @@ void test_c_type(const std::string& name_type, const T& value, const T& set_valu
 template <typename T>
 void test_add_c_member(rt::Struct& s, const std::string& name, const T& value)
 {
-    size_t struct_memory_size = s.memory_size();
     s.add_member(name, value);
 
     THEN("the c type member '" + name + "' is added")
@@ -73,7 +141,9 @@ void test_add_c_member(rt::Struct& s, const std::string& name, const T& value)
         REQUIRE(static_cast<const rt::CType<T>&>(s[name]).hash_code() == typeid(T).hash_code());
         REQUIRE(static_cast<const rt::CType<T>&>(s[name]).base_instance() == value);
         REQUIRE(s.member(name) != nullptr);
-        REQUIRE(s.member(name)->offset() == struct_memory_size);
+        REQUIRE(s.member(name)->offset() % alignof(T) == 0);
+        REQUIRE(s.member(name)->offset() + sizeof(T) <= s.memory_size());
+        REQUIRE(s.memory_size() % s.alignment() == 0);
         REQUIRE(&s.member(name)->type() == &s[name]);
     }
 }
@@ -81,7 +151,6 @@ void test_add_c_member(rt::Struct& s, const std::string& name, const T& value)
 template <typename T, typename... Args>
 void test_emplace_c_member(rt::Struct& s, const std::string& name, Args&&... args)
 {
-    size_t struct_memory_size = s.memory_size();
     s.add_member<T>(name, std::forward<Args>(args)...);
 
     THEN("the c type member '" + name + "' is emplaced")
@@ -92,14 +161,15 @@ void test_emplace_c_member(rt::Struct& s, const std::string& name, Args&&... arg
         REQUIRE(static_cast<const rt::CType<T>&>(s[name]).hash_code() == typeid(T).hash_code());
         REQUIRE(static_cast<const rt::CType<T>&>(s[name]).base_instance() == T(std::forward<Args>(args)...));
         REQUIRE(s.member(name) != nullptr);
-        REQUIRE(s.member(name)->offset() == struct_memory_size);
+        REQUIRE(s.member(name)->offset() % alignof(T) == 0);
+        REQUIRE(s.member(name)->offset() + sizeof(T) <= s.memory_size());
+        REQUIRE(s.memory_size() % s.alignment() == 0);
         REQUIRE(&s.member(name)->type() == &s[name]);
     }
 }
 
 void test_add_struct_member(rt::Struct& s, const std::string& name, rt::Struct& inner)
 {
-    size_t struct_memory_size = s.memory_size();
     s.add_member(name, inner);
 
     THEN("the struct type member '" + name + "' is added")
@@ -107,8 +177,9 @@ void test_add_struct_member(rt::Struct& s, const std::string& name, rt::Struct&
         REQUIRE(s[name].kind() == rt::Kind::Struct);
         REQUIRE(s[name].name() == inner.name());
         REQUIRE(s[name].memory_size() == inner.memory_size());
+        REQUIRE(s[name].alignment() == inner.alignment());
         REQUIRE(s.member(name) != nullptr);
-        REQUIRE(s.member(name)->offset() == struct_memory_size);
+        REQUIRE(s.member(name)->offset() % inner.alignment() == 0);
         REQUIRE(&s.member(name)->type() == &s[name]);
     }
 }
@@ -196,6 +267,7 @@ SCENARIO("unitary test")
             {
                 A() {}
                 A(const A&) {} //only requirement is to be copy constructible
+                A& operator=(const A&) = delete; //set rebuilds the value instead of assigning it
                 bool operator == (const A&) const { return true; } // used in the test only, no API mandatory
             };
             test_add_c_member(basic, "custom struct", A());
@@ -347,4 +419,1565 @@ SCENARIO("unitary test")
             }
         }
     }
+
+    GIVEN("structures with members of mixed alignment")
+    {
+        rt::Struct inner("inner");
+        inner.add_member<bool>("b");
+        inner.add_member<int64_t>("i64");
+        inner.add_member<char>("c");
+        inner.add_member<double>("d");
+        inner.add_member<int16_t>("i16");
+
+        rt::Struct outer("outer");
+        outer.add_member<char>("c");
+        outer.add_member("inner", inner);
+        outer.add_member<uint16_t>("u16");
+        outer.add_member<float>("f");
+
+        THEN("layout matches the compiler layout")
+        {
+            REQUIRE(inner.memory_size() == sizeof(CompiledInner));
+            REQUIRE(inner.alignment() == alignof(CompiledInner));
+            REQUIRE(inner.member("b")->offset() == offsetof(CompiledInner, b));
+            REQUIRE(inner.member("i64")->offset() == offsetof(CompiledInner, i64));
+            REQUIRE(inner.member("c")->offset() == offsetof(CompiledInner, c));
+            REQUIRE(inner.member("d")->offset() == offsetof(CompiledInner, d));
+            REQUIRE(inner.member("i16")->offset() == offsetof(CompiledInner, i16));
+
+            REQUIRE(outer.memory_size() == sizeof(CompiledOuter));
+            REQUIRE(outer.alignment() == alignof(CompiledOuter));
+            REQUIRE(outer.member("c")->offset() == offsetof(CompiledOuter, c));
+            REQUIRE(outer.member("inner")->offset() == offsetof(CompiledOuter, inner));
+            REQUIRE(outer.member("u16")->offset() == offsetof(CompiledOuter, u16));
+            REQUIRE(outer.member("f")->offset() == offsetof(CompiledOuter, f));
+        }
+
+        WHEN("data is created")
+        {
+            rt::Data d(outer);
+            d["inner"]["i64"].set<int64_t>(42);
+            d["inner"]["d"].set(2.5);
+
+            THEN("data is aligned")
+            {
+                REQUIRE(reinterpret_cast<uintptr_t>(d.memory()) % outer.alignment() == 0);
+                REQUIRE(reinterpret_cast<uintptr_t>(&d["inner"]["i64"].get<int64_t>()) % alignof(int64_t) == 0);
+                REQUIRE(reinterpret_cast<uintptr_t>(&d["inner"]["d"].get<double>()) % alignof(double) == 0);
+            }
+
+            THEN("data can be read as the compiled struct")
+            {
+                const CompiledOuter& compiled = *reinterpret_cast<const CompiledOuter*>(d.memory());
+                REQUIRE(compiled.inner.i64 == 42);
+                REQUIRE(compiled.inner.d == 2.5);
+            }
+        }
+
+        WHEN("a member is over-aligned")
+        {
+            rt::Struct wide("wide");
+            wide.add_member<char>("c");
+            wide.add_member<OverAligned>("over aligned");
+
+            rt::Data d(wide);
+
+            THEN("data memory respects the member alignment")
+            {
+                REQUIRE(wide.alignment() == alignof(OverAligned));
+                REQUIRE(wide.member("over aligned")->offset() == alignof(OverAligned));
+                REQUIRE(reinterpret_cast<uintptr_t>(d.memory()) % alignof(OverAligned) == 0);
+            }
+
+            THEN("the default instance of the member is aligned")
+            {
+                const auto& member_type = static_cast<const rt::CType<OverAligned>&>(wide["over aligned"]);
+                REQUIRE(reinterpret_cast<uintptr_t>(&member_type.base_instance()) % alignof(OverAligned) == 0);
+
+                std::unique_ptr<rt::Type> clone = member_type.clone();
+                const auto& cloned = static_cast<const rt::CType<OverAligned>&>(*clone);
+                REQUIRE(reinterpret_cast<uintptr_t>(&cloned.base_instance()) % alignof(OverAligned) == 0);
+            }
+        }
+    }
+
+    GIVEN("a structure with padding between members")
+    {
+        rt::Struct padded("padded");
+        padded.add_member<bool>("b", true);
+        padded.add_member<int64_t>("i64", 4);
+        padded.add_member<char>("c", 'A');
+        padded.add_member<double>("d", 2.0);
+        padded.add_member<int16_t>("i16", 16);
+
+        WHEN("is sealed with the compact layout")
+        {
+            padded.seal(rt::LayoutPolicy::Compact);
+
+            THEN("padding is reduced")
+            {
+                rt::LayoutReport report = padded.layout_report();
+                REQUIRE(report.declared_memory_size == sizeof(CompiledInner));
+                REQUIRE(report.memory_size == padded.memory_size());
+                REQUIRE(report.memory_size == 24);
+                REQUIRE(report.padding == 4);
+                REQUIRE(report.saved_bytes == sizeof(CompiledInner) - 24);
+            }
+
+            THEN("members keep their names and alignment")
+            {
+                REQUIRE(padded.member("i64")->offset() == 0);
+                REQUIRE(padded.member("d")->offset() == 8);
+                REQUIRE(padded.member("i16")->offset() == 16);
+                REQUIRE(padded.member("b")->offset() == 18);
+                REQUIRE(padded.member("c")->offset() == 19);
+            }
+
+            THEN("data is accessed by member names")
+            {
+                rt::Data d(padded);
+                test_data(d["b"], true, false);
+                test_data(d["i64"], (int64_t) 4, (int64_t) 8);
+                test_data(d["c"], 'A', 'B');
+                test_data(d["d"], 2.0, 3.0);
+                test_data(d["i16"], (int16_t) 16, (int16_t) 32);
+            }
+
+            THEN("no more members can be added")
+            {
+                REQUIRE(padded.sealed());
+                REQUIRE_THROWS_AS(padded.add_member<int>("int"), rt::MemberAddException);
+            }
+
+            THEN("the layout can not be changed by sealing again")
+            {
+                REQUIRE_THROWS_AS(padded.seal(), rt::MemberAddException);
+                REQUIRE_THROWS_AS(padded.seal(rt::LayoutPolicy::Compact), rt::MemberAddException);
+                REQUIRE(padded.member("i64")->offset() == 0);
+            }
+        }
+
+        WHEN("is sealed with the declared layout")
+        {
+            padded.seal();
+
+            THEN("layout is not modified")
+            {
+                REQUIRE(padded.memory_size() == sizeof(CompiledInner));
+                REQUIRE(padded.layout_report().saved_bytes == 0);
+                REQUIRE(padded.member("i64")->offset() == offsetof(CompiledInner, i64));
+            }
+        }
+    }
+
+    GIVEN("nested structures and accessors")
+    {
+        rt::Struct inner("inner");
+        inner.add_member<int>("id", 3);
+        inner.add_member<std::vector<int>>("values", std::vector<int>{1, 2});
+
+        rt::Struct outer("outer");
+        outer.add_member<std::string>("name", "name");
+        outer.add_member("inner", inner);
+
+        rt::Data d(outer);
+
+        WHEN("accessors are created")
+        {
+            rt::Accessor<int> id = outer.path<int>("inner.id");
+            rt::Accessor<std::vector<int>> values = outer.path<std::vector<int>>("inner.values");
+            rt::Accessor<std::string> name = outer.path<std::string>("name");
+
+            THEN("offsets are resolved")
+            {
+                REQUIRE(id.offset() == outer.member("inner")->offset() + inner.member("id")->offset());
+                REQUIRE(name.offset() == outer.member("name")->offset());
+            }
+
+            THEN("data is read")
+            {
+                REQUIRE(id.get(d) == 3);
+                REQUIRE(values.get(d) == (std::vector<int>{1, 2}));
+                REQUIRE(name.get(d) == "name");
+            }
+
+            THEN("data is written")
+            {
+                id.set(d, 7);
+                values.get_mut(d).push_back(3);
+                REQUIRE(d["inner"]["id"].get<int>() == 7);
+                REQUIRE(d["inner"]["values"].get<std::vector<int>>() == (std::vector<int>{1, 2, 3}));
+            }
+
+            THEN("data from other types is rejected")
+            {
+                rt::Data other(inner);
+                REQUIRE_THROWS_AS(id.get(other), rt::DataAccessException);
+            }
+        }
+
+        WHEN("accessor is relative to a nested struct")
+        {
+            rt::Accessor<int> id = inner.path<int>("id");
+            id.set(d["inner"], 9);
+            REQUIRE(d["inner"]["id"].get<int>() == 9);
+        }
+
+        WHEN("accessors are created with wrong paths or types")
+        {
+            REQUIRE_THROWS_AS(outer.path<int>("inner.unknown"), rt::MemberAccessException);
+            REQUIRE_THROWS_AS(outer.path<int>("name.id"), rt::MemberAccessException);
+            REQUIRE_THROWS_AS(outer.path<int>("inner"), rt::DataAccessException);
+            REQUIRE_THROWS_AS(outer.path<float>("inner.id"), rt::DataAccessException);
+        }
+
+        WHEN("the nested struct is used as a type of its own")
+        {
+            THEN("the nested instances are accepted")
+            {
+                REQUIRE(inner.equivalent(outer["inner"]));
+                REQUIRE(outer["inner"].equivalent(inner));
+
+                rt::DataArray array(inner);
+                array.push_back(d["inner"]);
+                REQUIRE(array[0]["values"].get<std::vector<int>>() == (std::vector<int>{1, 2}));
+            }
+
+            THEN("a struct with other definition is rejected")
+            {
+                rt::Struct changed(inner);
+                changed.add_member<int>("other");
+                REQUIRE_FALSE(changed.equivalent(outer["inner"]));
+
+                rt::Struct renamed("inner");
+                renamed.add_member<int>("key", 3);
+                renamed.add_member<std::vector<int>>("values");
+                REQUIRE(renamed.memory_size() == inner.memory_size());
+                REQUIRE_FALSE(renamed.equivalent(inner));
+
+                rt::Struct retyped("inner");
+                retyped.add_member<float>("id", 3.0f);
+                retyped.add_member<std::vector<int>>("values");
+                REQUIRE(retyped.memory_size() == inner.memory_size());
+                REQUIRE_FALSE(retyped.equivalent(inner));
+
+                rt::Struct unnamed;
+                rt::Data unnamed_data(unnamed);
+                rt::Accessor<int> id = inner.path<int>("id");
+                REQUIRE_THROWS_WITH(id.get(unnamed_data),
+                    "Accessor from type 'inner' can not be used with data of type <unnamed>.");
+            }
+        }
+    }
+
+    GIVEN("a structure with many members")
+    {
+        rt::Struct wide("wide");
+        for(int i = 0; i < 100; i++)
+        {
+            wide.add_member("member " + std::to_string(i), i);
+        }
+        wide.add_member<char>("char", 'A');
+        wide.add_member<double>("double", 1.0);
+
+        THEN("members are found by name")
+        {
+            for(int i = 0; i < 100; i++)
+            {
+                const rt::Member* member = wide.member("member " + std::to_string(i));
+                REQUIRE(member != nullptr);
+                REQUIRE(member->name() == "member " + std::to_string(i));
+                REQUIRE(static_cast<const rt::CType<int>&>(member->type()).base_instance() == i);
+            }
+            REQUIRE(wide.member("member 100") == nullptr);
+        }
+
+        THEN("members are sorted by offset")
+        {
+            const std::vector<rt::Member>& members = wide.members();
+            REQUIRE(members.size() == wide.member_size());
+            for(size_t i = 1; i < members.size(); i++)
+            {
+                REQUIRE(members[i - 1].offset() < members[i].offset());
+            }
+        }
+
+        WHEN("is sealed with the compact layout")
+        {
+            wide.seal(rt::LayoutPolicy::Compact);
+
+            THEN("members are sorted by offset and found by name")
+            {
+                REQUIRE(wide.members().front().name() == "double");
+                REQUIRE(wide.members().back().name() == "char");
+                REQUIRE(wide.member("member 50")->name() == "member 50");
+
+                rt::Data d(wide);
+                test_data(d["member 50"], 50, 3);
+            }
+        }
+    }
+
+    GIVEN("trivial and non trivial structures")
+    {
+        rt::Struct point("point");
+        point.add_member<double>("x", 1.0);
+        point.add_member<double>("y", 2.0);
+
+        rt::Struct trivial("trivial");
+        trivial.add_member<int>("id", 7);
+        trivial.add_member<char>("tag", 'T');
+        trivial.add_member("point", point);
+
+        rt::Struct mixed("mixed");
+        mixed.add_member<int>("id", 9);
+        mixed.add_member<std::string>("name", "mixed");
+        mixed.add_member("point", point);
+
+        THEN("triviality is propagated from members")
+        {
+            REQUIRE(rt::CType<int>().is_trivially_copyable());
+            REQUIRE(rt::CType<int>().is_trivially_destructible());
+            REQUIRE_FALSE(rt::CType<std::string>().is_trivially_copyable());
+            REQUIRE_FALSE(rt::CType<std::string>().is_trivially_destructible());
+
+            REQUIRE(trivial.is_trivially_copyable());
+            REQUIRE(trivial.is_trivially_destructible());
+            REQUIRE_FALSE(mixed.is_trivially_copyable());
+            REQUIRE_FALSE(mixed.is_trivially_destructible());
+        }
+
+        THEN("a C++ type is assigned")
+        {
+            rt::CType<std::string> a(std::string(40, 'a'));
+            rt::CType<std::string> b(std::string(40, 'b'));
+            a = b;
+            REQUIRE(a.base_instance() == std::string(40, 'b'));
+            REQUIRE(&a.base_instance() != &b.base_instance());
+
+            b = rt::CType<std::string>(std::string(40, 'c'));
+            REQUIRE(a.base_instance() == std::string(40, 'b'));
+            REQUIRE(b.base_instance() == std::string(40, 'c'));
+        }
+
+        WHEN("trivial data is created and copied")
+        {
+            rt::Data d(trivial);
+            test_data(d["id"], 7, 8);
+            test_data(d["tag"], 'T', 'U');
+            test_data(d["point"]["y"], 2.0, 3.0);
+
+            WHEN("data is copied")
+            {
+                d["point"]["x"].set(5.0);
+                rt::Data copy(d);
+                test_data(copy["point"]["x"], 5.0, 6.0);
+                test_data(copy["id"], 7, 1);
+            }
+        }
+
+        WHEN("mixed data is created and copied")
+        {
+            rt::Data d(mixed);
+            test_data(d["id"], 9, 8);
+            test_data(d["name"], std::string{"mixed"}, std::string{"set"});
+            test_data(d["point"]["x"], 1.0, 3.0);
+
+            WHEN("data is copied")
+            {
+                d["name"].set(std::string{"copied"});
+                rt::Data copy(d);
+                test_data(copy["name"], std::string{"copied"}, std::string{"set"});
+                test_data(copy["point"]["y"], 2.0, 3.0);
+            }
+        }
+
+        WHEN("mixed structure is nested")
+        {
+            rt::Struct outer("outer");
+            outer.add_member<char>("tag", 'O');
+            outer.add_member("mixed", mixed);
+
+            WHEN("data is created")
+            {
+                rt::Data d(outer);
+                test_data(d["tag"], 'O', 'P');
+                test_data(d["mixed"]["id"], 9, 8);
+                test_data(d["mixed"]["name"], std::string{"mixed"}, std::string{"set"});
+                test_data(d["mixed"]["point"]["y"], 2.0, 3.0);
+            }
+
+            WHEN("a member is added")
+            {
+                outer.add_member<std::string>("label", "label");
+                outer.add_member<float>("value", 4.0f);
+
+                rt::Data added(outer);
+                test_data(added["label"], std::string{"label"}, std::string{"set"});
+                test_data(added["value"], 4.0f, 5.0f);
+                test_data(added["mixed"]["point"]["x"], 1.0, 3.0);
+            }
+        }
+
+        WHEN("trivial structure is sealed with the compact layout")
+        {
+            trivial.seal(rt::LayoutPolicy::Compact);
+            rt::Data d(trivial);
+            test_data(d["id"], 7, 8);
+            test_data(d["tag"], 'T', 'U');
+            test_data(d["point"]["x"], 1.0, 3.0);
+        }
+    }
+
+    GIVEN("array types")
+    {
+        rt::Struct point("point");
+        point.add_member<float>("x", 1.0f);
+        point.add_member<std::string>("label", "point");
+
+        rt::Array points(point, 3);
+        rt::Array ints(rt::CType<int16_t>(7), 5);
+
+        THEN("arrays are declared")
+        {
+            REQUIRE(points.kind() == rt::Kind::Array);
+            REQUIRE(points.size() == 3);
+            REQUIRE(points.stride() == point.memory_size());
+            REQUIRE(points.memory_size() == 3 * point.memory_size());
+            REQUIRE(points.alignment() == point.alignment());
+            REQUIRE_FALSE(points.is_trivially_copyable());
+            REQUIRE(ints.memory_size() == 5 * sizeof(int16_t));
+            REQUIRE(ints.is_trivially_copyable());
+        }
+
+        WHEN("arrays are members")
+        {
+            rt::Struct path("path");
+            path.add_member<char>("tag", 'P');
+            path.add_member("points", points);
+            path.add_member("ints", ints);
+
+            rt::Data d(path);
+
+            THEN("elements are accessed by index")
+            {
+                test_data(d["points"][2]["x"], 1.0f, 2.0f);
+                test_data(d["points"][1]["label"], std::string{"point"}, std::string{"set"});
+                test_data(d["ints"][4], (int16_t) 7, (int16_t) 9);
+                REQUIRE_THROWS_AS(d["ints"][5], rt::MemberAccessException);
+                REQUIRE_THROWS_AS(d["tag"][0], rt::MemberAccessException);
+            }
+
+            THEN("elements are copied")
+            {
+                d["points"][0]["label"].set(std::string{"first"});
+                rt::Data copy(d);
+                test_data(copy["points"][0]["label"], std::string{"first"}, std::string{"set"});
+            }
+        }
+
+        WHEN("a data array is filled")
+        {
+            rt::DataArray array(point);
+            for(int i = 0; i < 10; i++)
+            {
+                array.push_back()["x"].set(static_cast<float>(i));
+            }
+
+            THEN("instances are placed back to back")
+            {
+                REQUIRE(array.size() == 10);
+                REQUIRE(array.capacity() >= 10);
+                REQUIRE(array[3].memory() == array.memory() + 3 * array.stride());
+                REQUIRE(array[9]["x"].get<float>() == 9.0f);
+                REQUIRE(array[5]["label"].get<std::string>() == "point");
+                REQUIRE_THROWS_AS(array.at(10), rt::DataAccessException);
+            }
+
+            THEN("instances are copied")
+            {
+                array[2]["label"].set(std::string{"second"});
+                array.push_back(array[2]);
+
+                rt::DataArray copy(array);
+                REQUIRE(copy.size() == 11);
+                REQUIRE(copy.back()["label"].get<std::string>() == "second");
+                REQUIRE(copy[7]["x"].get<float>() == 7.0f);
+
+                rt::Data other(point);
+                array.push_back(other);
+                REQUIRE(array.size() == 12);
+
+                rt::Struct unknown("unknown");
+                rt::Data unknown_data(unknown);
+                REQUIRE_THROWS_AS(array.push_back(unknown_data), rt::DataAccessException);
+            }
+
+            THEN("the instances are kept if a copy throws while the array grows")
+            {
+                rt::Struct throwing("throwing");
+                throwing.add_member<ThrowingCopy>("value");
+                throwing.add_member<std::string>("label", std::string(40, 'x'));
+                REQUIRE_FALSE(throwing.is_nothrow_movable());
+
+                const int alive = ThrowingCopy::alive;
+                {
+                    ThrowingCopy::copies_left = 100;
+                    rt::DataArray full(throwing);
+                    full.resize(4);
+                    REQUIRE(full.size() == full.capacity());
+
+                    ThrowingCopy::copies_left = 1;
+                    REQUIRE_THROWS_AS(full.push_back(), std::runtime_error);
+                    REQUIRE(full.size() == 4);
+                    REQUIRE(full.capacity() == 4);
+                    REQUIRE(ThrowingCopy::alive == alive + 4);
+                    REQUIRE(full[3]["label"].get<std::string>() == std::string(40, 'x'));
+
+                    ThrowingCopy::copies_left = 1;
+                    REQUIRE_THROWS_AS(full.push_back(full[0]), std::runtime_error);
+                    REQUIRE(full.size() == 4);
+                    REQUIRE(ThrowingCopy::alive == alive + 4);
+
+                    ThrowingCopy::copies_left = 100;
+                    full.push_back(full[0]);
+                    REQUIRE(full.size() == 5);
+                    REQUIRE(ThrowingCopy::alive == alive + 5);
+                }
+                REQUIRE(ThrowingCopy::alive == alive);
+            }
+
+            THEN("an instance of the array is copied when the array grows")
+            {
+                rt::DataArray full(point);
+                for(int i = 0; i < 4; i++)
+                {
+                    full.push_back()["label"].set(std::string(40, static_cast<char>('a' + i)));
+                }
+                REQUIRE(full.size() == full.capacity());
+
+                full.push_back(full[0]);
+                REQUIRE(full.size() == 5);
+                REQUIRE(full.capacity() > 5);
+                REQUIRE(full[4]["label"].get<std::string>() == std::string(40, 'a'));
+                REQUIRE(full[0]["label"].get<std::string>() == std::string(40, 'a'));
+                REQUIRE(full[3]["label"].get<std::string>() == std::string(40, 'd'));
+            }
+
+            THEN("array is resized")
+            {
+                array.resize(3);
+                REQUIRE(array.size() == 3);
+                array.resize(20);
+                REQUIRE(array.size() == 20);
+                REQUIRE(array[19]["x"].get<float>() == 1.0f);
+                REQUIRE(array[2]["x"].get<float>() == 2.0f);
+                array.clear();
+                REQUIRE(array.empty());
+            }
+        }
+    }
+
+    GIVEN("a table")
+    {
+        rt::Struct position("position");
+        position.add_member<double>("x", 1.0);
+        position.add_member<double>("y", 2.0);
+
+        rt::Struct record("record");
+        record.add_member<int>("id", 5);
+        record.add_member<std::string>("name", "record");
+        record.add_member("position", position);
+
+        rt::Table table(record);
+
+        THEN("each leaf member has its own column")
+        {
+            REQUIRE(table.column_size() == 4);
+            REQUIRE(table.column_paths() == (std::vector<std::string>{"id", "name", "position.x", "position.y"}));
+            REQUIRE(table.empty());
+        }
+
+        WHEN("rows are added")
+        {
+            table.reserve(10);
+            for(int i = 0; i < 10; i++)
+            {
+                table.push_back()["id"].set(i);
+            }
+            table.row(3)["name"].set(std::string{"third"});
+            table[4]["position.y"].set(8.0);
+
+            THEN("columns are contiguous")
+            {
+                rt::Column<int> ids = table.column<int>("id");
+                REQUIRE(ids.size() == 10);
+                for(int i = 0; i < 10; i++)
+                {
+                    REQUIRE(ids[i] == i);
+                    REQUIRE(&ids[i] == ids.data() + i);
+                }
+
+                rt::Column<const double> ys = static_cast<const rt::Table&>(table).column<double>("position.y");
+                REQUIRE(ys[4] == 8.0);
+                REQUIRE(ys[5] == 2.0);
+            }
+
+            THEN("rows are accessed as data")
+            {
+                test_data(table[3]["name"], std::string{"third"}, std::string{"set"});
+                test_data(table[9]["position.x"], 1.0, 5.0);
+            }
+
+            THEN("table is resized and copied")
+            {
+                table.resize(20);
+                REQUIRE(table.size() == 20);
+                REQUIRE(table.column<int>("id")[15] == 5);
+
+                rt::Table copy(table);
+                REQUIRE(copy.column<std::string>("name")[3] == "third");
+                REQUIRE(copy.size() == 20);
+            }
+
+            THEN("wrong columns are rejected")
+            {
+                REQUIRE_THROWS_AS(table.column<int>("position"), rt::MemberAccessException);
+                REQUIRE_THROWS_AS(table.column<float>("id"), rt::DataAccessException);
+                REQUIRE_THROWS_AS(table[20]["id"], rt::DataAccessException);
+            }
+        }
+
+        WHEN("the struct is wide")
+        {
+            rt::Struct wide("wide");
+            for(int i = 0; i < 200; i++)
+            {
+                wide.add_member<int>("column_" + std::to_string(i), i);
+            }
+            rt::Table wide_table(wide);
+            wide_table.push_back();
+
+            THEN("each path reaches its own column")
+            {
+                for(int i = 0; i < 200; i++)
+                {
+                    const std::string path = "column_" + std::to_string(i);
+                    REQUIRE(wide_table[0][path].get<int>() == i);
+                    REQUIRE(wide_table.column<int>(path)[0] == i);
+                }
+                REQUIRE_THROWS_AS(wide_table[0]["column_200"], rt::MemberAccessException);
+            }
+        }
+    }
+
+    GIVEN("a structure to serialize")
+    {
+        rt::Struct point("point");
+        point.add_member<double>("x", 1.0);
+        point.add_member<char>("tag", 'P');
+
+        rt::Struct record("record");
+        record.add_member<uint64_t>("id", 1);
+        record.add_member<int16_t>("flags", 3);
+        record.add_member("begin", point);
+        record.add_member<std::string>("name", "record");
+        record.add_member<std::vector<int>>("samples", std::vector<int>{1, 2, 3});
+        record.add_member<std::vector<std::string>>("labels", std::vector<std::string>{"a", "b"});
+        record.add_member("points", rt::Array(point, 2));
+
+        THEN("contiguous trivial members are merged into a single operation")
+        {
+            const std::vector<rt::SerialPlan::Op>& ops = record.serial_plan().ops();
+            REQUIRE(ops.size() == 5);
+            REQUIRE(ops[0].code == rt::SerialPlan::Code::Bytes);
+            REQUIRE(ops[0].offset == 0);
+            REQUIRE(ops[0].size == record.member("begin")->offset() + point.member("tag")->offset() + sizeof(char));
+            REQUIRE(ops[1].code == rt::SerialPlan::Code::Codec);
+            REQUIRE(ops[4].code == rt::SerialPlan::Code::Bytes);
+            REQUIRE(ops[4].size == point.memory_size() + point.member("tag")->offset() + sizeof(char));
+        }
+
+        WHEN("data is serialized and deserialized")
+        {
+            rt::Data d(record);
+            d["id"].set<uint64_t>(42);
+            d["begin"]["x"].set(-2.5);
+            d["name"].set(std::string{"serialized"});
+            d["samples"].set(std::vector<int>{4, 5, 6, 7});
+            d["labels"].set(std::vector<std::string>{"c"});
+            d["points"][1]["tag"].set('Q');
+
+            rt::Buffer buffer;
+            rt::serialize(d, buffer);
+            rt::serialize(d["begin"], buffer);
+
+            rt::Data read(record);
+            rt::Data read_point(point);
+            rt::deserialize(read, buffer);
+            rt::deserialize(read_point, buffer);
+
+            THEN("data is recovered")
+            {
+                REQUIRE(buffer.position() == buffer.size());
+                REQUIRE(read["id"].get<uint64_t>() == 42);
+                REQUIRE(read["flags"].get<int16_t>() == 3);
+                REQUIRE(read["begin"]["x"].get<double>() == -2.5);
+                REQUIRE(read["name"].get<std::string>() == "serialized");
+                REQUIRE(read["samples"].get<std::vector<int>>() == (std::vector<int>{4, 5, 6, 7}));
+                REQUIRE(read["labels"].get<std::vector<std::string>>() == (std::vector<std::string>{"c"}));
+                REQUIRE(read["points"][1]["tag"].get<char>() == 'Q');
+                REQUIRE(read_point["x"].get<double>() == -2.5);
+            }
+
+            THEN("truncated data is rejected")
+            {
+                rt::Buffer truncated;
+                truncated.assign(buffer.data(), buffer.size() / 2);
+                REQUIRE_THROWS_AS(rt::deserialize(read, truncated), rt::SerializationException);
+            }
+
+            THEN("corrupt length prefixes are rejected before allocating")
+            {
+                const uint64_t corrupt_size = uint64_t(1) << 40;
+
+                rt::Struct text;
+                text.add_member<std::string>("text");
+                rt::Data read_text(text);
+                rt::Buffer corrupt_text;
+                corrupt_text.write_size(corrupt_size);
+                corrupt_text.write("abc", 3);
+                REQUIRE_THROWS_AS(rt::deserialize(read_text, corrupt_text), rt::SerializationException);
+
+                rt::Struct samples;
+                samples.add_member<std::vector<int>>("samples");
+                rt::Data read_samples(samples);
+                rt::Buffer corrupt_samples;
+                corrupt_samples.write_size(corrupt_size);
+                corrupt_samples.write("abcdefgh", 8);
+                REQUIRE_THROWS_AS(rt::deserialize(read_samples, corrupt_samples), rt::SerializationException);
+
+                rt::Struct labels;
+                labels.add_member<std::vector<std::string>>("labels");
+                rt::Data read_labels(labels);
+                rt::Buffer corrupt_labels;
+                corrupt_labels.write_size(corrupt_size);
+                REQUIRE_THROWS_AS(rt::deserialize(read_labels, corrupt_labels), rt::SerializationException);
+            }
+        }
+
+        WHEN("a member has no codec")
+        {
+            record.add_member<std::map<int, int>>("map");
+            rt::Data d(record);
+            rt::Buffer buffer;
+            REQUIRE_THROWS_AS(rt::serialize(d, buffer), rt::SerializationException);
+        }
+    }
+
+    GIVEN("a structure with large members")
+    {
+        rt::Struct record("record");
+        record.add_member<int>("id", 1);
+        record.add_member<std::string>("name", std::string(100, 'a'));
+        record.add_member<std::vector<int>>("values", std::vector<int>(100, 7));
+
+        rt::Data d(record);
+        const char* name_memory = d["name"].get<std::string>().data();
+        const int* values_memory = d["values"].get<std::vector<int>>().data();
+
+        WHEN("data is moved")
+        {
+            rt::Data moved(std::move(d));
+
+            THEN("resources are transferred")
+            {
+                REQUIRE(moved["name"].get<std::string>().data() == name_memory);
+                REQUIRE(moved["values"].get<std::vector<int>>().data() == values_memory);
+                REQUIRE(moved["id"].get<int>() == 1);
+            }
+
+            WHEN("is assigned")
+            {
+                rt::Data other(record);
+                other = std::move(moved);
+                REQUIRE(other["name"].get<std::string>().data() == name_memory);
+
+                rt::Data copied(record);
+                copied = other;
+                REQUIRE(copied["name"].get<std::string>() == std::string(100, 'a'));
+                REQUIRE(copied["name"].get<std::string>().data() != name_memory);
+            }
+        }
+
+        WHEN("data is stored in a vector")
+        {
+            std::vector<rt::Data> datas;
+            datas.push_back(std::move(d));
+            for(int i = 0; i < 20; i++)
+            {
+                datas.emplace_back(record);
+            }
+
+            THEN("reallocations do not copy the members")
+            {
+                REQUIRE(datas[0]["name"].get<std::string>().data() == name_memory);
+            }
+        }
+
+        WHEN("data is swapped")
+        {
+            rt::Data other(record);
+            other["id"].set(2);
+            swap(d, other);
+            REQUIRE(d["id"].get<int>() == 2);
+            REQUIRE(other["name"].get<std::string>().data() == name_memory);
+        }
+
+        WHEN("values are moved into data")
+        {
+            std::vector<int> values(50, 3);
+            const int* memory = values.data();
+            d["values"].set(std::move(values));
+            REQUIRE(d["values"].get<std::vector<int>>().data() == memory);
+        }
+
+        WHEN("values are emplaced into data")
+        {
+            d["name"].emplace<std::string>(3, 'b');
+            d["values"].emplace<std::vector<int>>(2, 9);
+            REQUIRE(d["name"].get<std::string>() == "bbb");
+            REQUIRE(d["values"].get<std::vector<int>>() == (std::vector<int>{9, 9}));
+            REQUIRE_THROWS_AS(d["id"].emplace<float>(1.0f), rt::DataAccessException);
+        }
+
+        WHEN("data arrays grow")
+        {
+            rt::DataArray array(record);
+            array.push_back(d);
+            const char* element_memory = array[0]["name"].get<std::string>().data();
+            array.reserve(100);
+            REQUIRE(array[0]["name"].get<std::string>().data() == element_memory);
+
+            rt::DataArray moved(std::move(array));
+            REQUIRE(moved[0]["name"].get<std::string>().data() == element_memory);
+            REQUIRE(array.empty());
+        }
+    }
+
+    GIVEN("members updated with set")
+    {
+        struct NoAssignable
+        {
+            NoAssignable(int value) : value_(value) {}
+            const int value_;
+        };
+
+        rt::Struct record("record");
+        record.add_member<std::string>("name");
+        record.add_member<NoAssignable>("no assignable", 3);
+
+        rt::Data d(record);
+
+        WHEN("a string is set")
+        {
+            d["name"].get_mut<std::string>().reserve(200);
+            const char* memory = d["name"].get<std::string>().data();
+            const std::string first(100, 'a');
+            const std::string second(150, 'b');
+            d["name"].set(first);
+            d["name"].set(second);
+
+            THEN("its capacity is reused")
+            {
+                REQUIRE(d["name"].get<std::string>() == std::string(150, 'b'));
+                REQUIRE(d["name"].get<std::string>().data() == memory);
+            }
+
+            THEN("its own value can be set")
+            {
+                d["name"].set(d["name"].get<std::string>());
+                REQUIRE(d["name"].get<std::string>() == std::string(150, 'b'));
+            }
+        }
+
+        WHEN("a no assignable type is set")
+        {
+            d["no assignable"].set(NoAssignable(5));
+            REQUIRE(d["no assignable"].get<NoAssignable>().value_ == 5);
+
+            NoAssignable value(6);
+            d["no assignable"].set(value);
+            REQUIRE(d["no assignable"].get<NoAssignable>().value_ == 6);
+
+            record.path<NoAssignable>("no assignable").set(d, NoAssignable(7));
+            REQUIRE(d["no assignable"].get<NoAssignable>().value_ == 7);
+        }
+
+        WHEN("a type with an own assignment is set")
+        {
+            // Trivial copy constructor, user assignment.
+            struct Counted
+            {
+                Counted() = default;
+                Counted(const Counted&) = default;
+                Counted& operator=(const Counted& other) { value = other.value; assignments++; return *this; }
+                int value = 1;
+                int assignments = 0;
+            };
+
+            rt::Struct counted("counted");
+            counted.add_member<Counted>("value");
+            rt::Data data(counted);
+            rt::Accessor<Counted> accessor = counted.path<Counted>("value");
+
+            Counted other;
+            other.value = 2;
+            data["value"].set(other);
+            REQUIRE(data["value"].get<Counted>().assignments == 1);
+            REQUIRE(data["value"].get<Counted>().value == 2);
+
+            other.value = 3;
+            accessor.set(data, other);
+            REQUIRE(data["value"].get<Counted>().assignments == 2);
+            REQUIRE(accessor.get(data).value == 3);
+        }
+    }
+
+    GIVEN("type identifiers")
+    {
+        THEN("registered types have fixed identifiers")
+        {
+            REQUIRE(rt::type_id<bool>() == 1);
+            REQUIRE(rt::type_id<int>() == 7);
+            REQUIRE(rt::type_id<int32_t>() == rt::type_id<int>());
+            REQUIRE(rt::type_id<double>() == 14);
+            REQUIRE(rt::type_id<RegisteredPod>() == 1000);
+            REQUIRE(rt::CType<RegisteredPod>().id() == 1000);
+        }
+
+        THEN("other types have unique identifiers")
+        {
+            REQUIRE(rt::type_id<std::string>() != rt::NO_TYPE_ID);
+            REQUIRE(rt::type_id<std::string>() == rt::type_id<std::string>());
+            REQUIRE(rt::type_id<std::string>() != rt::type_id<std::vector<int>>());
+            REQUIRE(rt::type_id<std::string>() > 255);
+        }
+
+        THEN("types with no C++ type have no identifier")
+        {
+            REQUIRE(rt::Struct().id() == rt::NO_TYPE_ID);
+            REQUIRE(rt::Array(rt::CType<int>(), 2).id() == rt::NO_TYPE_ID);
+        }
+
+        THEN("data access checks the identifier")
+        {
+            rt::CType<int> type(3);
+            rt::Data d(type);
+            REQUIRE(d.get<int>() == 3);
+            REQUIRE_THROWS_AS(d.get<unsigned int>(), rt::DataAccessException);
+            REQUIRE_THROWS_AS(d.get<std::string>(), rt::DataAccessException);
+        }
+    }
+
+    GIVEN("unchecked data access")
+    {
+        rt::Struct type;
+        type.add_member<int>("id", 1);
+        type.add_member<std::string>("name", "a");
+
+        rt::Data data(type);
+
+        THEN("values are read and written as with the checked access")
+        {
+            REQUIRE(data["id"].get_unchecked<int>() == 1);
+
+            data["id"].set_unchecked(2);
+            data["name"].set_unchecked(std::string("bb"));
+            std::string name = "ccc";
+            data["name"].set_unchecked(name);
+
+            REQUIRE(data["id"].get<int>() == 2);
+            REQUIRE(data["name"].get<std::string>() == "ccc");
+            REQUIRE(name == "ccc");
+        }
+    }
+
+    GIVEN("non-throwing access")
+    {
+        rt::Struct inner;
+        inner.add_member<int>("id", 3);
+
+        rt::Struct type;
+        type.add_member<float>("value", 1.5f);
+        type.add_member("inner", inner);
+
+        rt::Data data(type);
+        const rt::Data& const_data = data;
+
+        THEN("find returns the member or an empty reference")
+        {
+            REQUIRE(type.find("value") == &type["value"]);
+            REQUIRE(type.find("missing") == nullptr);
+
+            rt::ReadableDataRef value = const_data.find("value");
+            REQUIRE(value);
+            REQUIRE(*value.try_get<float>() == 1.5f);
+            REQUIRE(value.try_get<int>() == nullptr);
+
+            REQUIRE_FALSE(const_data.find("missing"));
+            REQUIRE_FALSE(const_data.find("value").find("x"));
+            REQUIRE_FALSE(const_data.find("missing").find("x"));
+            REQUIRE(const_data.find("missing").try_get<int>() == nullptr);
+            REQUIRE(*const_data.find("inner").find("id").try_get<int>() == 3);
+        }
+
+        THEN("writable references can be found")
+        {
+            rt::WritableDataRef id = data.find("inner").find("id");
+            REQUIRE(id);
+            *id.try_get_mut<int>() = 4;
+            REQUIRE(data["inner"]["id"].get<int>() == 4);
+            REQUIRE(data.find("inner").try_get_mut<int>() == nullptr);
+            REQUIRE_FALSE(data.find("missing"));
+        }
+    }
+
+    GIVEN("symbols")
+    {
+        THEN("equal names are interned once")
+        {
+            rt::Symbol a("symbol_name");
+            rt::Symbol b(std::string("symbol_") + "name");
+            rt::Symbol c("other_symbol_name");
+
+            REQUIRE(a == b);
+            REQUIRE(a != c);
+            REQUIRE(a.name() == "symbol_name");
+            REQUIRE(a.hash() == rt::hash_name("symbol_name", 11));
+            REQUIRE(&a.name() == &b.name());
+        }
+
+        THEN("members are accessed by symbol")
+        {
+            rt::Struct inner;
+            inner.add_member<int>("id", 3);
+
+            rt::Struct type;
+            type.add_member<float>("value", 1.5f);
+            type.add_member("inner", inner);
+
+            const rt::Symbol value("value");
+            const rt::Symbol inner_name("inner");
+            const rt::Symbol id("id");
+            const rt::Symbol missing("missing");
+
+            REQUIRE(type.member(value) == type.member("value"));
+            REQUIRE(type.member(value)->symbol() == value);
+            REQUIRE(&type[value] == &type["value"]);
+            REQUIRE(type.find(missing) == nullptr);
+            REQUIRE_THROWS_AS(type[missing], rt::MemberAccessException);
+
+            rt::Data data(type);
+            data[inner_name][id].set(4);
+            REQUIRE(data["inner"]["id"].get<int>() == 4);
+            REQUIRE(data[value].get<float>() == 1.5f);
+            REQUIRE(data.find(inner_name).find(id));
+            REQUIRE_FALSE(data.find(missing));
+            REQUIRE_THROWS_AS(data[missing], rt::MemberAccessException);
+
+            const rt::Data& const_data = data;
+            REQUIRE(const_data[inner_name][id].get<int>() == 4);
+            REQUIRE_FALSE(const_data.find(missing));
+        }
+    }
+
+    GIVEN("a sealed struct with many members")
+    {
+        rt::Struct type;
+        for(int i = 0; i < 1000; i++)
+        {
+            type.add_member<int>("member_" + std::to_string(i), i);
+        }
+
+        WHEN("sealed with the declared layout")
+        {
+            type.seal();
+
+            THEN("every member is found by name and by symbol")
+            {
+                rt::Data data(type);
+                for(int i = 0; i < 1000; i++)
+                {
+                    const std::string name = "member_" + std::to_string(i);
+                    REQUIRE(type.member(name) != nullptr);
+                    REQUIRE(type.member(name)->name() == name);
+                    REQUIRE(type.member(rt::Symbol(name)) == type.member(name));
+                    REQUIRE(data[name].get<int>() == i);
+                }
+                REQUIRE(type.member("member_1000") == nullptr);
+                REQUIRE(type.member(rt::Symbol("member_x")) == nullptr);
+                REQUIRE_THROWS_AS(type.add_member<int>("other"), rt::MemberAddException);
+            }
+        }
+
+        WHEN("sealed with the compact layout")
+        {
+            type.add_member<char>("small", 'a');
+            type.seal(rt::LayoutPolicy::Compact);
+
+            THEN("every member is found by name")
+            {
+                rt::Data data(type);
+                REQUIRE(data["small"].get<char>() == 'a');
+                for(int i = 0; i < 1000; i++)
+                {
+                    REQUIRE(data["member_" + std::to_string(i)].get<int>() == i);
+                }
+            }
+        }
+    }
+
+    GIVEN("a perfect index")
+    {
+        rt::PerfectIndex index;
+        auto any = [](uint32_t) { return true; };
+
+        THEN("each hash is placed in its own slot")
+        {
+            std::vector<uint64_t> hashes;
+            for(uint32_t i = 0; i < 500; i++)
+            {
+                hashes.push_back(rt::hash_name(reinterpret_cast<const char*>(&i), sizeof(i)));
+            }
+            REQUIRE(index.build(hashes));
+            for(uint32_t i = 0; i < 500; i++)
+            {
+                REQUIRE(index.find(hashes[i], any) == i);
+            }
+        }
+
+        THEN("repeated hashes can not be indexed")
+        {
+            REQUIRE_FALSE(index.build({1, 2, 1}));
+            REQUIRE(index.empty());
+            REQUIRE(index.find(1, any) == static_cast<uint32_t>(rt::PerfectIndex::npos));
+        }
+    }
+
+    GIVEN("a struct with nested structs")
+    {
+        rt::Struct point;
+        point.add_member<float>("x", 1.0f);
+        point.add_member<float>("y", 2.0f);
+
+        rt::Struct segment;
+        segment.add_member<char>("tag", 't');
+        segment.add_member("begin", point);
+        segment.add_member("end", point);
+
+        rt::Struct shape;
+        shape.add_member<std::string>("name", "shape");
+        shape.add_member("segment", segment);
+
+        THEN("every member has a flattened path")
+        {
+            REQUIRE(shape.member_paths().size() == 9);
+
+            const rt::MemberPath* end_y = shape.member_path("segment.end.y");
+            REQUIRE(end_y != nullptr);
+            REQUIRE(end_y->path == "segment.end.y");
+            REQUIRE(end_y->type->is<float>());
+            REQUIRE(end_y->offset == shape.member("segment")->offset()
+                + segment.member("end")->offset() + point.member("y")->offset());
+
+            REQUIRE(shape.member_path("segment")->type == &shape["segment"]);
+            REQUIRE(shape.member_path("segment.end.z") == nullptr);
+            REQUIRE(shape.member_path("segment.") == nullptr);
+        }
+
+        THEN("data is accessed by path")
+        {
+            rt::Data data(shape);
+            data.at("segment.end.y").set(5.0f);
+
+            REQUIRE(data["segment"]["end"]["y"].get<float>() == 5.0f);
+            REQUIRE(data.at("segment.begin.y").get<float>() == 2.0f);
+            REQUIRE(data.at("segment").at("end.y").get<float>() == 5.0f);
+            REQUIRE(static_cast<const rt::Data&>(data).at("name").get<std::string>() == "shape");
+            REQUIRE_THROWS_AS(data.at("segment.end.z"), rt::MemberAccessException);
+            REQUIRE_THROWS_AS(data.at("name.x"), rt::MemberAccessException);
+        }
+
+        THEN("a copied struct has its own paths")
+        {
+            rt::Struct copy(shape);
+            REQUIRE(copy.member_path("name")->type == &copy["name"]);
+            REQUIRE(copy.member_path("segment.end.y")->type == shape.member_path("segment.end.y")->type);
+        }
+
+        WHEN("sealed with the compact layout")
+        {
+            shape.add_member<char>("flag", 'f');
+            shape.seal(rt::LayoutPolicy::Compact);
+
+            THEN("the paths follow the new offsets")
+            {
+                rt::Data data(shape);
+                REQUIRE(shape.member_path("flag")->offset == shape.member("flag")->offset());
+                REQUIRE(data.at("flag").get<char>() == 'f');
+                REQUIRE(data.at("segment.tag").get<char>() == 't');
+                REQUIRE(data.at("segment.end.x").get<float>() == 1.0f);
+            }
+        }
+    }
+
+    GIVEN("non trivial members in nested structs")
+    {
+        rt::Struct leaf;
+        leaf.add_member<int>("id", 1);
+        leaf.add_member<Tracked>("tracked");
+        leaf.add_member<std::string>("text", "leaf text longer than the small buffer");
+
+        rt::Struct middle;
+        middle.add_member<char>("c", 'c');
+        middle.add_member("first", leaf);
+        middle.add_member("second", leaf);
+
+        rt::Struct root;
+        root.add_member<Tracked>("tracked");
+        root.add_member("middle", middle);
+        root.add_member("values", rt::Array(leaf, 2));
+
+        THEN("every non trivial member is built, copied and destroyed once")
+        {
+            const int alive = Tracked::alive;
+            {
+                rt::Data data(root);
+                REQUIRE(Tracked::alive == alive + 5);
+                REQUIRE(data.at("middle.second.text").get<std::string>() == "leaf text longer than the small buffer");
+                REQUIRE(data["values"][1]["text"].get<std::string>() == "leaf text longer than the small buffer");
+
+                data.at("middle.second.text").set(std::string("changed"));
+                rt::Data copy(data);
+                REQUIRE(Tracked::alive == alive + 10);
+                REQUIRE(copy.at("middle.second.text").get<std::string>() == "changed");
+                REQUIRE(copy.at("middle.first.text").get<std::string>() == "leaf text longer than the small buffer");
+
+                rt::Data moved(std::move(copy));
+                REQUIRE(Tracked::alive == alive + 10);
+            }
+            REQUIRE(Tracked::alive == alive);
+        }
+    }
+
+    GIVEN("data refs")
+    {
+        THEN("they are trivially copyable handles of two pointers")
+        {
+            REQUIRE(std::is_trivially_copyable<rt::ReadableDataRef>::value);
+            REQUIRE(std::is_trivially_copyable<rt::WritableDataRef>::value);
+            REQUIRE(std::is_trivially_copyable<rt::DataView>::value);
+            REQUIRE_FALSE(std::is_polymorphic<rt::ReadableDataRef>::value);
+            REQUIRE(sizeof(rt::ReadableDataRef) == 2 * sizeof(void*));
+            REQUIRE(sizeof(rt::DataView) == 2 * sizeof(void*));
+        }
+    }
+
+    GIVEN("shared types")
+    {
+        THEN("a nested struct is a snapshot that does not depend on the original")
+        {
+            rt::Struct outer;
+            {
+                rt::Struct inner("inner");
+                inner.add_member<std::string>("text", "text longer than the small string buffer");
+                outer.add_member("inner", inner);
+                inner.add_member<int>("later", 1);
+            }
+
+            REQUIRE(outer.member_path("inner.later") == nullptr);
+
+            rt::Data data(outer);
+            REQUIRE(data.at("inner.text").get<std::string>() == "text longer than the small string buffer");
+        }
+
+        THEN("a struct copy shares the member types")
+        {
+            std::unique_ptr<rt::Struct> original(new rt::Struct("original"));
+            original->add_member<std::map<int, float>>("values", std::map<int, float>{{1, 1.5f}});
+
+            rt::Struct copy(*original);
+            REQUIRE(&copy["values"] == &(*original)["values"]);
+            REQUIRE(copy.member("values")->type_ref().use_count() == 2);
+
+            original.reset();
+            REQUIRE(copy.member("values")->type_ref().use_count() == 1);
+
+            rt::Data data(copy);
+            REQUIRE(data["values"].get<std::map<int, float>>().at(1) == 1.5f);
+        }
+
+        THEN("a shared type is shared instead of copied")
+        {
+            rt::Struct point("point");
+            point.add_member<float>("x", 1.0f);
+
+            rt::TypeRef shared = rt::TypeRef::share(point);
+            REQUIRE(shared.get() != &point);
+            REQUIRE(shared.use_count() == 1);
+            REQUIRE(rt::TypeRef::share(*shared).get() == shared.get());
+
+            const rt::Struct& shared_point = static_cast<const rt::Struct&>(*shared);
+            rt::Struct segment;
+            segment.add_member("begin", shared_point);
+            segment.add_member("end", shared_point);
+            rt::Array points(shared_point, 4);
+
+            REQUIRE(&segment["begin"] == shared.get());
+            REQUIRE(&segment["end"] == shared.get());
+            REQUIRE(&points.element() == shared.get());
+            REQUIRE(shared.use_count() == 4);
+
+            rt::TypeRef copy = shared;
+            REQUIRE(shared.use_count() == 5);
+        }
+    }
+
+    GIVEN("a pool allocator")
+    {
+        rt::PoolAllocator& pool = rt::PoolAllocator::instance();
+        pool.trim();
+        pool.reset_stats();
+
+        THEN("released blocks are reused by the allocations of the same size class")
+        {
+            uint8_t* first = pool.allocate(40, 8);
+            REQUIRE(reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t) == 0);
+            pool.deallocate(first, 40, 8);
+            REQUIRE(pool.cached_blocks(40) == 1);
+
+            uint8_t* second = pool.allocate(33, 4);
+            REQUIRE(second == first);
+            REQUIRE(pool.stats().hits == 1);
+            REQUIRE(pool.stats().misses == 1);
+
+            uint8_t* other_class = pool.allocate(200, 8);
+            REQUIRE(pool.stats().misses == 2);
+
+            pool.deallocate(second, 33, 4);
+            pool.deallocate(other_class, 200, 8);
+            pool.trim();
+            REQUIRE(pool.cached_blocks(40) == 0);
+        }
+
+        THEN("big and over-aligned blocks are taken from the heap")
+        {
+            uint8_t* big = pool.allocate(4096, 8);
+            uint8_t* aligned = pool.allocate(64, 64);
+            REQUIRE(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+            pool.deallocate(big, 4096, 8);
+            pool.deallocate(aligned, 64, 64);
+
+            REQUIRE(pool.cached_blocks(64) == 0);
+            REQUIRE(pool.stats().misses == 2);
+            REQUIRE(pool.stats().hits == 0);
+        }
+
+        THEN("data instances use the pool")
+        {
+            rt::Struct type;
+            type.add_member<std::string>("text", "pooled");
+            type.add_member<double>("value", 2.5);
+
+            {
+                rt::Data data(type, pool);
+                rt::Data copy(data);
+                REQUIRE(&copy.allocator() == &pool);
+                REQUIRE(copy["text"].get<std::string>() == "pooled");
+            }
+            REQUIRE(pool.cached_blocks(type.memory_size()) == 2);
+
+            rt::Data reused(type, pool);
+            REQUIRE(pool.stats().hits == 1);
+            REQUIRE(reused["value"].get<double>() == 2.5);
+        }
+    }
+
+    GIVEN("an arena")
+    {
+        rt::Arena arena(256);
+
+        rt::Struct tracked;
+        tracked.add_member<Tracked>("tracked");
+        tracked.add_member<std::string>("text", "a text longer than the small string buffer");
+
+        rt::Struct pod;
+        pod.add_member<int>("a", 3);
+        pod.add_member<double>("b", 1.5);
+
+        THEN("release destroys the instances of non trivially destructible types")
+        {
+            const int alive = Tracked::alive;
+            for(int i = 0; i < 10; i++)
+            {
+                rt::DataView data = arena.create(tracked);
+                REQUIRE(data["text"].get<std::string>() == "a text longer than the small string buffer");
+            }
+            REQUIRE(Tracked::alive == alive + 10);
+
+            arena.release();
+            REQUIRE(Tracked::alive == alive);
+            REQUIRE(arena.used() == 0);
+        }
+
+        THEN("instances of trivial types are built with their default values")
+        {
+            rt::DataView data = arena.create(pod);
+            REQUIRE(data["a"].get<int>() == 3);
+            REQUIRE(data["b"].get<double>() == 1.5);
+            REQUIRE(arena.used() == pod.memory_size());
+        }
+
+        THEN("the memory is reused after a release")
+        {
+            const uint8_t* first = arena.create(pod).memory();
+            arena.create(tracked);
+            const size_t capacity = arena.capacity();
+
+            arena.release();
+            REQUIRE(arena.create(pod).memory() == first);
+            REQUIRE(arena.capacity() == capacity);
+        }
+
+        THEN("the instances are aligned")
+        {
+            rt::Struct wide;
+            wide.add_member<OverAligned>("over aligned");
+
+            arena.create(pod);
+            rt::DataView data = arena.create(wide);
+            REQUIRE(reinterpret_cast<uintptr_t>(data.memory()) % alignof(OverAligned) == 0);
+        }
+
+        THEN("the instances that do not fit take new chunks")
+        {
+            std::vector<rt::DataView> views;
+            for(int i = 0; i < 100; i++)
+            {
+                views.push_back(arena.create(pod));
+                views.back()["a"].set(i);
+            }
+            REQUIRE(arena.capacity() > 256);
+            REQUIRE(arena.used() >= 100 * pod.memory_size());
+            for(int i = 0; i < 100; i++)
+            {
+                REQUIRE(views[i]["a"].get<int>() == i);
+            }
+        }
+
+        THEN("data instances can be built in the arena")
+        {
+            const int alive = Tracked::alive;
+            {
+                rt::Data data(tracked, arena);
+                REQUIRE(&data.allocator() == &arena);
+                REQUIRE(Tracked::alive == alive + 1);
+            }
+            REQUIRE(Tracked::alive == alive);
+            REQUIRE(arena.used() > 0);
+        }
+    }
+
+    GIVEN("data small enough to be inline")
+    {
+        rt::Struct small;
+        small.add_member<Tracked>("tracked");
+        small.add_member<std::string>("text", "a text longer than the small string buffer");
+        small.add_member<int>("id", 1);
+
+        rt::Struct big;
+        big.add_member<std::array<uint8_t, 100>>("bytes");
+        big.add_member<int>("id", 2);
+
+        THEN("only the small instances of the heap allocator are inline")
+        {
+            rt::Struct wide;
+            wide.add_member<OverAligned>("over aligned");
+
+            REQUIRE(rt::Data(small).is_inline());
+            REQUIRE_FALSE(rt::Data(big).is_inline());
+            REQUIRE_FALSE(rt::Data(wide).is_inline());
+            REQUIRE_FALSE(rt::Data(small, rt::PoolAllocator::instance()).is_inline());
+            REQUIRE(reinterpret_cast<uintptr_t>(rt::Data(small).memory()) % alignof(std::max_align_t) == 0);
+        }
+
+        THEN("moves transfer the members and destroy the source")
+        {
+            const int alive = Tracked::alive;
+            {
+                rt::Data data(small);
+                data["id"].set(5);
+                const char* text = data["text"].get<std::string>().data();
+
+                rt::Data moved(std::move(data));
+                REQUIRE(moved.is_inline());
+                REQUIRE(moved.memory() != data.memory());
+                REQUIRE(moved["text"].get<std::string>().data() == text);
+                REQUIRE(moved["id"].get<int>() == 5);
+                REQUIRE(Tracked::alive == alive + 1);
+
+                rt::Data assigned(small);
+                assigned = std::move(moved);
+                REQUIRE(assigned["text"].get<std::string>().data() == text);
+                REQUIRE(Tracked::alive == alive + 1);
+            }
+            REQUIRE(Tracked::alive == alive);
+        }
+
+        THEN("the instances of types that can throw while moving are not inline")
+        {
+            struct CopyOnly
+            {
+                CopyOnly() {}
+                CopyOnly(const CopyOnly&) {} // Can throw, used also to move
+            };
+
+            rt::Struct copy_only;
+            copy_only.add_member<CopyOnly>("value");
+            copy_only.add_member<int>("id", 3);
+            REQUIRE_FALSE(copy_only.is_nothrow_movable());
+            REQUIRE(small.is_nothrow_movable());
+            REQUIRE_FALSE(rt::Array(copy_only, 2).is_nothrow_movable());
+
+            rt::Data data(copy_only);
+            REQUIRE_FALSE(data.is_inline());
+
+            const uint8_t* memory = data.memory();
+            rt::Data moved(std::move(data));
+            REQUIRE(moved.memory() == memory);
+            REQUIRE(moved["id"].get<int>() == 3);
+        }
+
+        THEN("inline and allocated instances are swapped")
+        {
+            rt::Data inline_data(small);
+            rt::Data allocated(big);
+            inline_data["id"].set(7);
+
+            swap(inline_data, allocated);
+            REQUIRE(&inline_data.type() == &big);
+            REQUIRE_FALSE(inline_data.is_inline());
+            REQUIRE(inline_data["id"].get<int>() == 2);
+            REQUIRE(&allocated.type() == &small);
+            REQUIRE(allocated.is_inline());
+            REQUIRE(allocated["id"].get<int>() == 7);
+
+            rt::Data other(small);
+            swap(allocated, other);
+            REQUIRE(allocated["id"].get<int>() == 1);
+            REQUIRE(other["id"].get<int>() == 7);
+            REQUIRE(other["text"].get<std::string>() == "a text longer than the small string buffer");
+        }
+    }
 }